@@ -1,6 +1,12 @@
 #import "CNMApplicationDelegate.h"
 #import <MessageUI/MessageUI.h>
 #import "CNMVideoFeedManager.h"
+#import "CNMVideoDecoderBenchmark.h"
+#import "CNMNetworkConditionsURLProtocol.h"
+#import "CNMReplayURLProtocol.h"
+#import "CNMNetworkTransport.h"
+#import "CNMNetworkMetrics.h"
+#import "CNMVimeoRequest.h"
 #import "Mixpanel.h"
 
 
@@ -60,6 +66,20 @@ static NSString * const kCNMMixPanelToken = @"de020e9b125f767e365459f4d2865781";
  */
 - (void)setupPushNotifications;
 
+/**
+ @brief  Open connection to remote data provider and resolve hosts from which images and videos of previous
+         session's feed has been loaded.
+ */
+- (void)prewarmConnections;
+
+#if DEBUG
+/**
+ @brief  Point requests to local stand-in which replay recorded responses and load network conditions scenario
+         if it has been requested with launch arguments.
+ */
+- (void)setupNetworkStandIn;
+#endif
+
 #pragma mark -
 
 
@@ -75,16 +95,48 @@ static NSString * const kCNMMixPanelToken = @"de020e9b125f767e365459f4d2865781";
     
     // Setup tracking tools.
     [self setupTrackingTools];
+
+#if DEBUG
+    // Setup local data provider stand-in.
+    [self setupNetworkStandIn];
+#endif
+    
+    // Open connections while user interface is prepared.
+    [self prewarmConnections];
     
     // Prepare user interface.
     [self prepareInterface];
     
     // Setup push notifications.
     [self setupPushNotifications];
+    
+#if DEBUG
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"CNMRunDecoderBenchmark"]) {
+        
+        [CNMVideoDecoderBenchmark runWithEntriesCount:1000 iterations:10];
+    }
+#endif
      
     return YES;
 }
 
+- (void)applicationDidEnterBackground:(UIApplication *)application {
+    
+#if DEBUG
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"CNMDumpNetworkMetrics"]) {
+        
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES)[0];
+        NSString *path = [cachesPath stringByAppendingPathComponent:@"network-metrics.json"];
+        NSError *error = nil;
+        if ([[CNMNetworkMetrics sharedMetrics] writeToFile:path error:&error]) {
+            
+            NSLog(@"<Continuum::Metrics> Network metrics written to %@", path);
+        }
+        else { NSLog(@"<Continuum::Metrics> Network metrics can't be written: %@", error); }
+    }
+#endif
+}
+
 - (void)application:(UIApplication *)application didRegisterForRemoteNotificationsWithDeviceToken:(NSData *)deviceToken {
 #if !TARGET_IPHONE_SIMULATOR    
     [[Mixpanel sharedInstance].people addPushDeviceToken:deviceToken];
@@ -196,6 +248,46 @@ static NSString * const kCNMMixPanelToken = @"de020e9b125f767e365459f4d2865781";
     [[UIApplication sharedApplication] registerForRemoteNotifications];
 }
 
+- (void)prewarmConnections {
+    
+    CNMNetworkTransport *transport = [CNMNetworkTransport sharedTransport];
+    [transport prewarmConnectionToURL:[CNMVimeoRequest baseURL]];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        
+        [transport resolveHosts:[CNMVideoFeedManager hostsOfStoredFeed]];
+    });
+}
+
+#if DEBUG
+- (void)setupNetworkStandIn {
+    
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    NSString *path = [defaults stringForKey:@"CNMReplayRecordings"];
+    if (path.length) {
+        
+        // Relative recordings path is resolved against caches directory.
+        if (!path.isAbsolutePath) {
+            
+            NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES)[0];
+            path = [cachesPath stringByAppendingPathComponent:path];
+        }
+        NSURL *upstreamURL = ([defaults boolForKey:@"CNMReplayRecord"] ? [CNMVimeoRequest baseURL] : nil);
+        NSTimeInterval latency = ([defaults doubleForKey:@"CNMReplayLatency"] / 1000.0f);
+        NSUInteger bandwidth = (NSUInteger)MAX([defaults integerForKey:@"CNMReplayBandwidth"], 0) * 1024;
+        [CNMReplayURLProtocol setRecordingsPath:path latency:latency bandwidth:bandwidth upstreamURL:upstreamURL];
+        [CNMVimeoRequest setBaseURL:[CNMReplayURLProtocol baseURL]];
+        NSLog(@"<Continuum::Replay> Replaying responses from %@%@", path, (upstreamURL ? @" (recording)" : @""));
+    }
+    
+    NSString *scenarioPath = [defaults stringForKey:@"CNMNetworkScenario"];
+    NSError *error = nil;
+    if (scenarioPath.length && ![CNMNetworkConditionsURLProtocol loadScenarioFromFile:scenarioPath error:&error]) {
+        
+        NSLog(@"<Continuum::Conditions> Scenario can't be loaded: %@", error);
+    }
+}
+#endif
+
 
 #pragma mark - UITabBarController delegate methods
 
@@ -6,6 +6,8 @@
 #import "CNMFeedViewController.h"
 #import "CNMVideoEntryCollectionViewCell.h"
 #import "CNMVideoEntryInformationView.h"
+#import "CNMVideoFeedPrefetchController.h"
+#import "CNMFeedLoadingBenchmark.h"
 #import "CNMVideoViewController.h"
 #import "CNMVideoFeedManager.h"
 #import "Mixpanel.h"
@@ -89,9 +91,9 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
 @property (nonatomic, assign) BOOL hasOlderEntriesToLoad;
 
 /**
- @brief  Stores whether application currently fetch older records or not.
+ @brief  Stores reference on controller which request older entries before user will reach end of the feed.
  */
-@property (nonatomic, assign) BOOL fetchingOlderEntries;
+@property (nonatomic) CNMVideoFeedPrefetchController *prefetchController;
 
 
 #pragma mark - Interface customization
@@ -132,11 +134,6 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
  */
 - (void)fetchLatestEntries:(BOOL)prefetchFromCache withCompletion:(dispatch_block_t)block;
 
-/**
- @brief  Retrieve older video entries from cache or remoted data provider.
- */
-- (void)fetchOlderEntries;
-
 
 #pragma mark - Handlers
 
@@ -147,6 +144,28 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
  */
 - (void)handleInitialFeedDidLoad:(NSArray<CNMVideo *> *)videos;
 
+/**
+ @brief  Handle information update for entry which already has been shown.
+ 
+ @param video Reference on updated video entry.
+ */
+- (void)handleEntryUpdate:(CNMVideo *)video;
+
+/**
+ @brief  Handle feed update with entries which has been restored from stubs or compacted to stubs.
+ 
+ @param videos Reference on list of all video entries.
+ */
+- (void)handleFeedUpdate:(NSArray<CNMVideo *> *)videos;
+
+/**
+ @brief  Handle older video entries fetch completion.
+ 
+ @param videos Reference on list of all fetched video entries.
+ @param error  Reference on fetch error (if any).
+ */
+- (void)handleOlderFeedDidLoad:(NSArray<CNMVideo *> *)videos withError:(NSError *)error;
+
 /**
  @brief  Handle refresh control pull.
  
@@ -215,7 +234,7 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
     CNMVideoViewController *videoController = (CNMVideoViewController *)segue.destinationViewController;
     [videoController prepareForVideo:video withManager:self.feedManager];
 #if !TARGET_IPHONE_SIMULATOR
-    [[Mixpanel sharedInstance] track:@"Play video" properties:@{@"Title": video.name, 
+    [[Mixpanel sharedInstance] track:@"Play video" properties:@{@"Title": (video.name ?: @""),
                                                                 @"Identifier": video.identifier}];
 #endif
 }
@@ -244,10 +263,12 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
 
 - (void)upateVideoInformation:(CNMVideo *)video {
     
+    [self.feedManager updateResidentEntriesAroundEntry:video];
+    [self.feedManager prefetchPresetsAroundEntry:video];
     [self.informationView upateForVideo:video];
 #if !TARGET_IPHONE_SIMULATOR
     [[Mixpanel sharedInstance] track:@"View video cover" 
-                          properties:@{@"Title": video.name, @"Identifier": video.identifier}];
+                          properties:@{@"Title": (video.name ?: @""), @"Identifier": video.identifier}];
 #endif
 }
 
@@ -256,10 +277,33 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
 
 - (void)prepareDataProvider {
     
+#if DEBUG
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    if ([defaults boolForKey:@"CNMRunFeedBenchmark"]) {
+        
+        NSInteger pagesCount = [defaults integerForKey:@"CNMFeedBenchmarkPages"];
+        [CNMFeedLoadingBenchmark runWithAccessToken:kCNMClientAccessToken channel:kCNMContinuumChannelIdentifier
+                                         pagesCount:(pagesCount > 0 ? (NSUInteger)pagesCount : 5)];
+        return;
+    }
+#endif
     self.feedManager = [CNMVideoFeedManager managerWithClientAccessToken:kCNMClientAccessToken];
     [self.feedManager setChannelIentifier:kCNMContinuumChannelIdentifier];
     
     __weak __typeof__(self) weakSelf = self;
+    self.feedManager.entryUpdateHandler = ^(CNMVideo *video) { [weakSelf handleEntryUpdate:video]; };
+    self.feedManager.feedUpdateHandler = ^(NSArray<CNMVideo *> *feed) { [weakSelf handleFeedUpdate:feed]; };
+    self.prefetchController = [CNMVideoFeedPrefetchController controllerWithFeedManager:self.feedManager];
+    self.prefetchController.pageLoadHandler = ^(NSArray<CNMVideo *> *feed, NSError *error) {
+        
+        [weakSelf handleOlderFeedDidLoad:feed withError:error];
+    };
+    
+    // Show feed from previous session while it is revalidated.
+    [self.feedManager restoreStoredFeedWithCompletion:^(NSArray<CNMVideo *> *feed) {
+        
+        [weakSelf handleInitialFeedDidLoad:feed];
+    }];
     [self.feedManager fetchNewestFeedWithCompletion:^(NSArray<CNMVideo *> *feed, NSError *error) {
         
         [weakSelf handleInitialFeedDidLoad:feed];
@@ -291,34 +335,6 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
     }];
 }
 
-- (void)fetchOlderEntries {
-    
-    if (!self.fetchingOlderEntries) {
-        
-        self.fetchingOlderEntries = YES;
-        __block __weak typeof(self) weakSelf = self;
-        [self.feedManager fetchNextFeedPageWithCompletion:^(NSArray<CNMVideo *> *feed, NSError *error) {
-            
-            __block __strong typeof(self) strongSelf = weakSelf;
-            strongSelf.fetchingOlderEntries = NO;
-            if (!error) {
-                
-                if (strongSelf.hasOlderEntriesToLoad) {
-                    
-                    strongSelf.hasOlderEntriesToLoad = (feed.lastObject.idx.unsignedIntegerValue > 1);
-                }
-                
-                if (feed) {
-                    
-                    strongSelf.feed = feed;
-                    [strongSelf.feedsCollectionView reloadData];
-                }
-            }
-            else { [strongSelf showRequestError]; }
-        }];
-    }
-}
-
 
 #pragma mark - UICollectionView delegate methods
 
@@ -336,6 +352,8 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
                                                          forIndexPath:indexPath];
     if (indexPath.row < self.feed.count) {
         
+        // Entry may be compacted if user scroll too fast (restored entry will be passed with entry update).
+        [self.feedManager prepareEntryForDisplay:self.feed[indexPath.row]];
         [(CNMVideoEntryCollectionViewCell *)cell upateForVideo:self.feed[indexPath.row]];
     }
     
@@ -351,6 +369,19 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
     return size;
 }
 
+- (void)collectionView:(UICollectionView *)collectionView willDisplayCell:(UICollectionViewCell *)cell
+    forItemAtIndexPath:(NSIndexPath *)indexPath {
+    
+    if (indexPath.row == self.feed.count) {
+        
+        [self.prefetchController handleLoadingEntryShow];
+#if !TARGET_IPHONE_SIMULATOR
+        [[Mixpanel sharedInstance] track:@"View feed loading entry"
+                              properties:@{@"Count": @(self.prefetchController.loadingEntryShowCount)}];
+#endif
+    }
+}
+
 
 #pragma mark- UIScrollView delegate methods
 
@@ -362,6 +393,19 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
     }];
 }
 
+- (void)scrollViewWillEndDragging:(UIScrollView *)scrollView withVelocity:(CGPoint)velocity
+              targetContentOffset:(inout CGPoint *)targetContentOffset {
+    
+    if (self.hasOlderEntriesToLoad) {
+        
+        // Velocity reported in points per millisecond.
+        CGFloat pageHeight = scrollView.frame.size.height;
+        NSUInteger page = MAX(targetContentOffset->y, 0.0f) / pageHeight;
+        [self.prefetchController updateForVisibleEntryAtIndex:page ofEntriesCount:self.feed.count
+                                                     velocity:(velocity.y * 1000.0f / pageHeight)];
+    }
+}
+
 - (void)scrollViewDidEndDecelerating:(UIScrollView *)scrollView {
     
     NSUInteger page = scrollView.contentOffset.y / scrollView.frame.size.height;
@@ -372,10 +416,9 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
         self.informationView.alpha = 1.0f;
     }];
     
-    if (self.hasOlderEntriesToLoad && scrollView.contentOffset.y > scrollView.frame.size.height &&
-        scrollView.contentOffset.y + scrollView.frame.size.height ==scrollView.contentSize.height) {
+    if (self.hasOlderEntriesToLoad) {
         
-        [self fetchOlderEntries];
+        [self.prefetchController updateForVisibleEntryAtIndex:page ofEntriesCount:self.feed.count velocity:0.0f];
     }
 }
 
@@ -405,6 +448,56 @@ static NSString * const kCNMVideoLoadCellViewIdentifier = @"CNMVideoLoadCellIden
     }
 }
 
+- (void)handleEntryUpdate:(CNMVideo *)video {
+    
+    // Updated entry is a copy, so it should replace entry in shown feed for cells which will be configured later.
+    NSUInteger index = [self.feed indexOfObjectPassingTest:^BOOL(CNMVideo *entry, NSUInteger entryIdx,
+                                                                 BOOL *entriesEnumeratorStop) {
+        
+        return [entry.identifier isEqualToString:video.identifier];
+    }];
+    if (index != NSNotFound) {
+        
+        NSMutableArray<CNMVideo *> *feed = [self.feed mutableCopy];
+        feed[index] = video;
+        self.feed = feed;
+        
+        NSIndexPath *indexPath = [NSIndexPath indexPathForItem:(NSInteger)index inSection:0];
+        id cell = [self.feedsCollectionView cellForItemAtIndexPath:indexPath];
+        if ([cell isKindOfClass:CNMVideoEntryCollectionViewCell.class]) {
+            
+            [(CNMVideoEntryCollectionViewCell *)cell upateForVideo:video];
+        }
+    }
+    
+    // Only visible entry information is shown, so there is no need to reload feed.
+    [self.informationView updateForChangedVideo:video];
+}
+
+- (void)handleFeedUpdate:(NSArray<CNMVideo *> *)videos {
+    
+    // List with different entries count will be shown along with page which has been merged into it.
+    if (videos.count == self.feed.count) { self.feed = videos; }
+}
+
+- (void)handleOlderFeedDidLoad:(NSArray<CNMVideo *> *)videos withError:(NSError *)error {
+    
+    if (!error) {
+        
+        if (self.hasOlderEntriesToLoad) {
+            
+            self.hasOlderEntriesToLoad = (videos.lastObject.idx.unsignedIntegerValue > 1);
+        }
+        
+        if (videos) {
+            
+            self.feed = videos;
+            [self.feedsCollectionView reloadData];
+        }
+    }
+    else { [self showRequestError]; }
+}
+
 - (void)handlePullForNewData:(UIRefreshControl *)control {
     
     [self fetchLatestEntries:(control == nil) withCompletion:^{
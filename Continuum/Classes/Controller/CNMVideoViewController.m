@@ -350,7 +350,11 @@ static NSString * const kCNMVideoDesiredQuality = @"hls";
             
             [self.loadIndicatorView startAnimating];
             __weak __typeof__(self) weakSelf = self;
-            [self.manager fetchAndUpdateDataForVideo:self.video withCompletion:^{ [weakSelf fetchPreset]; }];
+            [self.manager fetchAndUpdateDataForVideo:self.video withCompletion:^(CNMVideo *video) {
+                
+                weakSelf.video = video;
+                [weakSelf fetchPreset];
+            }];
         }
         else { [self showVideoNotReadyAlert]; }
     }
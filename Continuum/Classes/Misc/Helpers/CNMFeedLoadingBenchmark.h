@@ -0,0 +1,46 @@
+#import <Foundation/Foundation.h>
+
+
+#if DEBUG
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      End-to-end video feed loading benchmark.
+ @discussion Benchmark drive own video feed manager from first page through requested number of pages and wait
+             for credits of all loaded entries. It report time to first page, time to all pages, time to all
+             credits, bytes received for each endpoint and heap growth. To get reproducible results it should be
+             run against stand-in which replay recorded responses (\c CNMReplayURLProtocol). Available only in
+             debug builds and can be started with \c -CNMRunFeedBenchmark \c YES launch argument
+             (\c -CNMFeedBenchmarkPages is optional). Feed isn't loaded for user interface while benchmark run.
+             Benchmark use own transport and feed storage, so it doesn't reuse or change application's
+             connections, cached responses, metrics and stored feed.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMFeedLoadingBenchmark : NSObject
+
+
+///------------------------------------------------
+/// @name Measurement
+///------------------------------------------------
+
+/**
+ @brief  Start benchmark and log results when it will be completed.
+ 
+ @param token      Reference on access token which should be used with requests.
+ @param identifier Reference on identifier of channel which should be loaded.
+ @param pagesCount How many feed pages should be loaded.
+ */
++ (void)runWithAccessToken:(NSString *)token channel:(NSString *)identifier pagesCount:(NSUInteger)pagesCount;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif // DEBUG
@@ -0,0 +1,317 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMFeedLoadingBenchmark.h"
+#if DEBUG
+#import <malloc/malloc.h>
+#import "CNMNetworkMetricsHistogram.h"
+#import "CNMNetworkTransport.h"
+#import "CNMVideoFeedManager.h"
+#import "CNMNetworkMetrics.h"
+#import "CNMResponseCache.h"
+#import "CNMVideo.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores how long benchmark wait for credits after all pages has been loaded.
+ */
+static NSTimeInterval const kCNMCreditsWaitTimeout = 30.0f;
+
+/**
+ @brief  Stores reference on name which is used by benchmark for stored feed and responses, so application's
+         feed snapshot, records of compacted entries and response cache stay untouched.
+ */
+static NSString * const kCNMBenchmarkStorageName = @"com.continuumluxury.continuum.benchmark";
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMFeedLoadingBenchmark ()
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on manager which load feed while benchmark run.
+ */
+@property (nonatomic, nullable) CNMVideoFeedManager *manager;
+
+/**
+ @brief  Stores reference on transport which has own connections, response cache and metrics.
+ */
+@property (nonatomic, nullable) CNMNetworkTransport *transport;
+
+/**
+ @brief  Stores reference on access token which should be used with requests.
+ */
+@property (nonatomic, copy) NSString *accessToken;
+
+/**
+ @brief  Stores reference on identifier of channel which should be loaded.
+ */
+@property (nonatomic, copy) NSString *channelIdentifier;
+
+/**
+ @brief  Stores how many feed pages should be loaded.
+ */
+@property (nonatomic, assign) NSUInteger pagesCount;
+
+/**
+ @brief  Stores how many feed pages has been loaded so far.
+ */
+@property (nonatomic, assign) NSUInteger loadedPagesCount;
+
+/**
+ @brief  Stores number of entries in last loaded feed.
+ */
+@property (nonatomic, assign) NSUInteger entriesCount;
+
+/**
+ @brief  Stores reference on identifiers of loaded entries which still wait for credits.
+ */
+@property (nonatomic) NSMutableSet<NSString *> *entriesWithoutCredits;
+
+/**
+ @brief  Stores when benchmark has been started and when it's stages has been completed.
+ */
+@property (nonatomic, assign) CFAbsoluteTime startDate;
+@property (nonatomic, assign) CFAbsoluteTime firstPageDate;
+@property (nonatomic, assign) CFAbsoluteTime allPagesDate;
+@property (nonatomic, assign) CFAbsoluteTime allCreditsDate;
+
+/**
+ @brief  Stores number of heap bytes which has been in use when benchmark has been started.
+ */
+@property (nonatomic, assign) size_t initialHeapSize;
+
+/**
+ @brief  Stores whether results already has been reported.
+ */
+@property (nonatomic, assign, getter = isCompleted) BOOL completed;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize benchmark.
+ 
+ @param token      Reference on access token which should be used with requests.
+ @param identifier Reference on identifier of channel which should be loaded.
+ @param pagesCount How many feed pages should be loaded.
+ 
+ @return Initialized and ready to use benchmark.
+ */
+- (instancetype)initWithAccessToken:(NSString *)token channel:(NSString *)identifier
+                         pagesCount:(NSUInteger)pagesCount;
+
+
+#pragma mark - Measurement
+
+/**
+ @brief  Create feed manager and start first page loading.
+ */
+- (void)start;
+
+/**
+ @brief  Handle feed page loading completion and load next page if required.
+ 
+ @param feed  Reference on list of loaded entries.
+ @param error Reference on page loading error.
+ */
+- (void)handleFeed:(NSArray<CNMVideo *> *)feed withError:(NSError *)error;
+
+/**
+ @brief  Handle entry update with credits.
+ 
+ @param video Reference on updated entry.
+ */
+- (void)handleEntryUpdate:(CNMVideo *)video;
+
+/**
+ @brief  Report results if all pages and credits has been loaded.
+ */
+- (void)completeIfReady;
+
+/**
+ @brief  Report results and release feed manager.
+ */
+- (void)complete;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Retrieve number of heap bytes which is in use.
+ 
+ @return Heap size in bytes.
+ */
++ (size_t)heapSize;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMFeedLoadingBenchmark
+
+
+#pragma mark - Initialization and Configuration
+
+- (instancetype)initWithAccessToken:(NSString *)token channel:(NSString *)identifier
+                         pagesCount:(NSUInteger)pagesCount {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _accessToken = [token copy];
+        _channelIdentifier = [identifier copy];
+        _pagesCount = MAX(pagesCount, 1);
+        _entriesWithoutCredits = [NSMutableSet new];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Measurement
+
++ (void)runWithAccessToken:(NSString *)token channel:(NSString *)identifier pagesCount:(NSUInteger)pagesCount {
+    
+    // Benchmark kept alive by manager's handlers till it will be completed.
+    [[[self alloc] initWithAccessToken:token channel:identifier pagesCount:pagesCount] start];
+}
+
+- (void)start {
+    
+    // Responses stored by previous run removed, so all requests reach stand-in or remote data provider.
+    self.transport = [CNMNetworkTransport transportWithName:[kCNMBenchmarkStorageName
+                                                             stringByAppendingPathExtension:@"responses"]];
+    [self.transport.responseCache removeAllResponses];
+    self.initialHeapSize = [CNMFeedLoadingBenchmark heapSize];
+    self.startDate = CFAbsoluteTimeGetCurrent();
+    self.manager = [CNMVideoFeedManager managerWithClientAccessToken:self.accessToken
+                                                         storageName:kCNMBenchmarkStorageName
+                                                           transport:self.transport];
+    [self.manager setChannelIentifier:self.channelIdentifier];
+    self.manager.entryUpdateHandler = ^(CNMVideo *video) { [self handleEntryUpdate:video]; };
+    [self.manager fetchNewestFeedWithCompletion:^(NSArray<CNMVideo *> *feed, NSError *error) {
+        
+        [self handleFeed:feed withError:error];
+    }];
+}
+
+- (void)handleFeed:(NSArray<CNMVideo *> *)feed withError:(NSError *)error {
+    
+    if (self.isCompleted) { return; }
+    if (error) {
+        
+        NSLog(@"<Continuum::Benchmark> Feed loading failed: %@", error);
+        [self complete];
+        return;
+    }
+    
+    // Feed doesn't have more pages if entries count hasn't been changed.
+    BOOL hasMorePages = (self.loadedPagesCount == 0 || feed.count > self.entriesCount);
+    self.loadedPagesCount += (hasMorePages ? 1 : 0);
+    self.entriesCount = feed.count;
+    if (self.firstPageDate == 0.0f) { self.firstPageDate = CFAbsoluteTimeGetCurrent(); }
+    [self.entriesWithoutCredits removeAllObjects];
+    for (CNMVideo *video in feed) {
+        
+        if (!video.author.length) { [self.entriesWithoutCredits addObject:video.identifier]; }
+    }
+    
+    if (hasMorePages && self.loadedPagesCount < self.pagesCount) {
+        
+        [self.manager fetchNextFeedPageWithCompletion:^(NSArray<CNMVideo *> *nextFeed, NSError *nextPageError) {
+            
+            [self handleFeed:nextFeed withError:nextPageError];
+        }];
+    }
+    else {
+        
+        self.allPagesDate = CFAbsoluteTimeGetCurrent();
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kCNMCreditsWaitTimeout * NSEC_PER_SEC)),
+                       dispatch_get_main_queue(), ^{ [self complete]; });
+        [self completeIfReady];
+    }
+}
+
+- (void)handleEntryUpdate:(CNMVideo *)video {
+    
+    if (video.author.length) { [self.entriesWithoutCredits removeObject:video.identifier]; }
+    [self completeIfReady];
+}
+
+- (void)completeIfReady {
+    
+    if (self.allPagesDate > 0.0f && self.entriesWithoutCredits.count == 0) {
+        
+        self.allCreditsDate = CFAbsoluteTimeGetCurrent();
+        [self complete];
+    }
+}
+
+- (void)complete {
+    
+    if (self.isCompleted) { return; }
+    self.completed = YES;
+    
+    CNMNetworkMetrics *metrics = self.transport.metrics;
+    for (NSString *endpoint in metrics.endpoints) {
+        
+        CNMNetworkMetricsHistogram *firstByte = [metrics histogramForMetric:CNMNetworkFirstByteTimeMetric
+                                                                 ofEndpoint:endpoint];
+        CNMNetworkMetricsHistogram *compressed = [metrics histogramForMetric:CNMNetworkCompressedBytesMetric
+                                                                  ofEndpoint:endpoint];
+        CNMNetworkMetricsHistogram *decompressed = [metrics histogramForMetric:CNMNetworkDecompressedBytesMetric
+                                                                    ofEndpoint:endpoint];
+        NSLog(@"<Continuum::Benchmark> %@: %lu responses, first byte p50 %.2f ms p95 %.2f ms, %.1f KB on the wire, "
+              "%.1f KB decompressed", endpoint, (unsigned long)firstByte.count, [firstByte valueAtPercentile:0.5f],
+              [firstByte valueAtPercentile:0.95f], compressed.sum / 1024.0f, decompressed.sum / 1024.0f);
+    }
+    
+    NSString *creditsTime = [NSString stringWithFormat:@"timed out (%lu entries w/o credits)",
+                             (unsigned long)self.entriesWithoutCredits.count];
+    if (self.allCreditsDate > 0.0f) {
+        
+        creditsTime = [NSString stringWithFormat:@"%.2f ms", (self.allCreditsDate - self.startDate) * 1000.0f];
+    }
+    double heapGrowth = ((double)[CNMFeedLoadingBenchmark heapSize] - (double)self.initialHeapSize) / 1024.0f;
+    NSLog(@"<Continuum::Benchmark> Feed: %lu pages (%lu entries), first page %.2f ms, all pages %.2f ms, "
+          "all credits %@, heap growth %.1f KB", (unsigned long)self.loadedPagesCount,
+          (unsigned long)self.entriesCount, (self.firstPageDate - self.startDate) * 1000.0f,
+          (self.allPagesDate > 0.0f ? (self.allPagesDate - self.startDate) * 1000.0f : 0.0f), creditsTime,
+          heapGrowth);
+    
+    // Break retain cycle between benchmark and manager's handlers.
+    self.manager.entryUpdateHandler = nil;
+    self.manager = nil;
+    [self.transport invalidate];
+    self.transport = nil;
+}
+
+
+#pragma mark - Misc
+
++ (size_t)heapSize {
+    
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    
+    return statistics.size_in_use;
+}
+
+#pragma mark -
+
+
+@end
+
+#endif // DEBUG
@@ -0,0 +1,40 @@
+#import <Foundation/Foundation.h>
+
+
+#if DEBUG
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Side-by-side comparison of video feed decoding ways.
+ @discussion Benchmark generate large synthetic channel pages and measure time which is required to decode them
+             with \b NSJSONSerialization and dictionary mapping and with \b CNMVideoDecoder. Available only in
+             debug builds and can be started with \c -CNMRunDecoderBenchmark \c YES launch argument.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoDecoderBenchmark : NSObject
+
+
+///------------------------------------------------
+/// @name Measurement
+///------------------------------------------------
+
+/**
+ @brief  Run benchmark on background queue and log results.
+ 
+ @param entriesCount How many video entries should be placed into synthetic channel page.
+ @param iterations   How many times each decoding way should be measured.
+ */
++ (void)runWithEntriesCount:(NSUInteger)entriesCount iterations:(NSUInteger)iterations;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif // DEBUG
@@ -0,0 +1,179 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoDecoderBenchmark.h"
+#if DEBUG
+#import "CNMVideo+Private.h"
+#import "CNMVideoDecoder.h"
+
+
+#pragma mark Private interface declaration
+
+@interface CNMVideoDecoderBenchmark ()
+
+
+#pragma mark - Data
+
+/**
+ @brief  Compose channel page which has same layout as remote data provider response.
+ 
+ @param entriesCount How many video entries should be placed into page.
+ 
+ @return Binary representation of channel page.
+ */
++ (NSData *)channelPageWithEntriesCount:(NSUInteger)entriesCount;
+
+/**
+ @brief  Compose video entry which has same layout as remote data provider response.
+ 
+ @param entryIdx Index of entry which is used to make entry unique.
+ 
+ @return Dictionary which represent single video entry.
+ */
++ (NSDictionary *)videoEntryWithIndex:(NSUInteger)entryIdx;
+
+
+#pragma mark - Measurement
+
+/**
+ @brief  Measure how long it take to run passed block.
+ 
+ @param iterations How many times \c block should be called.
+ @param block      Reference on block which should be measured.
+ 
+ @return Fastest run duration in seconds.
+ */
++ (CFTimeInterval)measure:(NSUInteger)iterations block:(dispatch_block_t)block;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoDecoderBenchmark
+
+
+#pragma mark - Measurement
+
++ (void)runWithEntriesCount:(NSUInteger)entriesCount iterations:(NSUInteger)iterations {
+    
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        
+        NSData *page = [self channelPageWithEntriesCount:entriesCount];
+        __block NSUInteger dictionaryEntriesCount = 0;
+        CFTimeInterval dictionaryDuration = [self measure:iterations block:^{
+            
+            NSDictionary *response = [NSJSONSerialization JSONObjectWithData:page options:(NSJSONReadingOptions)0
+                                                                       error:nil];
+            NSMutableArray *videos = [NSMutableArray new];
+            for (NSDictionary *information in response[@"data"]) {
+                
+                CNMVideo *video = [CNMVideo new];
+                [video mapDataFromDictionary:information];
+                [videos addObject:video];
+            }
+            dictionaryEntriesCount = videos.count;
+        }];
+        
+        __block NSUInteger decoderEntriesCount = 0;
+        CFTimeInterval decoderDuration = [self measure:iterations block:^{
+            
+            decoderEntriesCount = [[CNMVideoDecoder decoder] videosFromCollection:@"data" inData:page].count;
+        }];
+        
+        NSLog(@"<Continuum::Benchmark> %lu entries (%.1f KB): dictionary mapping %.2f ms (%lu entries), "
+              "direct decoder %.2f ms (%lu entries), speedup x%.2f", (unsigned long)entriesCount,
+              (double)page.length / 1024.0f, dictionaryDuration * 1000.0f, (unsigned long)dictionaryEntriesCount,
+              decoderDuration * 1000.0f, (unsigned long)decoderEntriesCount,
+              (decoderDuration > 0.0f ? dictionaryDuration / decoderDuration : 0.0f));
+    });
+}
+
++ (CFTimeInterval)measure:(NSUInteger)iterations block:(dispatch_block_t)block {
+    
+    CFTimeInterval fastestDuration = DBL_MAX;
+    for (NSUInteger iterationIdx = 0; iterationIdx < MAX(iterations, 1); iterationIdx++) {
+        
+        @autoreleasepool {
+            
+            CFTimeInterval start = CFAbsoluteTimeGetCurrent();
+            block();
+            fastestDuration = MIN(fastestDuration, CFAbsoluteTimeGetCurrent() - start);
+        }
+    }
+    
+    return fastestDuration;
+}
+
+
+#pragma mark - Data
+
++ (NSData *)channelPageWithEntriesCount:(NSUInteger)entriesCount {
+    
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:entriesCount];
+    for (NSUInteger entryIdx = 0; entryIdx < entriesCount; entryIdx++) {
+        
+        [entries addObject:[self videoEntryWithIndex:entryIdx]];
+    }
+    NSDictionary *page = @{@"total": @(entriesCount), @"page": @1, @"per_page": @(entriesCount),
+                           @"paging": @{@"next": [NSNull null], @"previous": [NSNull null],
+                                        @"first": @"/channels/benchmark/videos?page=1",
+                                        @"last": @"/channels/benchmark/videos?page=1"},
+                           @"data": entries};
+    
+    return [NSJSONSerialization dataWithJSONObject:page options:(NSJSONWritingOptions)0 error:nil];
+}
+
++ (NSDictionary *)videoEntryWithIndex:(NSUInteger)entryIdx {
+    
+    NSString *link = [NSString stringWithFormat:@"https://vimeo.com/%lu", (unsigned long)(150000000 + entryIdx)];
+    NSMutableArray *sizes = [NSMutableArray new];
+    for (NSNumber *width in @[@100, @200, @295, @640, @960, @1280, @1920]) {
+        
+        NSUInteger height = (NSUInteger)(width.doubleValue * 9.0f / 16.0f);
+        [sizes addObject:@{@"width": width, @"height": @(height),
+                           @"link": [NSString stringWithFormat:@"https://i.vimeocdn.com/video/%lu_%@x%lu.jpg",
+                                     (unsigned long)entryIdx, width, (unsigned long)height]}];
+    }
+    
+    NSMutableArray *files = [NSMutableArray new];
+    NSArray *qualities = @[@"hd", @"hd", @"sd", @"sd", @"mobile", @"hls"];
+    NSArray *widths = @[@1920, @1280, @960, @640, @480, [NSNull null]];
+    [qualities enumerateObjectsUsingBlock:^(NSString *quality, NSUInteger qualityIdx,
+                                            BOOL *qualitiesEnumeratorStop) {
+        
+        NSString *fileLink = [NSString stringWithFormat:@"https://player.vimeo.com/external/%lu.%@.mp4?s=%lu",
+                              (unsigned long)entryIdx, quality, (unsigned long)qualityIdx];
+        id height = ([widths[qualityIdx] isKindOfClass:NSNumber.class] ?
+                     @(((NSNumber *)widths[qualityIdx]).unsignedIntegerValue * 9 / 16) : [NSNull null]);
+        [files addObject:@{@"quality": quality, @"type": @"video/mp4", @"width": widths[qualityIdx],
+                           @"height": height, @"link": fileLink, @"link_secure": fileLink,
+                           @"created_time": @"2016-03-01T12:00:00+00:00", @"fps": @25,
+                           @"size": @(1024 * 1024 * (qualityIdx + 1) + entryIdx),
+                           @"md5": @"6a1c3b2e58c1d0a9b7a0f54d0e28cbb2"}];
+    }];
+    
+    return @{@"uri": [NSString stringWithFormat:@"/videos/%lu", (unsigned long)(150000000 + entryIdx)],
+             @"name": [NSString stringWithFormat:@"Synthetic \"benchmark\" video #%lu", (unsigned long)entryIdx],
+             @"description": @"Long description which is not used by data models.\nIt should be skipped.",
+             @"link": link, @"duration": @(60 + entryIdx), @"width": @1920, @"height": @1080,
+             @"language": [NSNull null], @"created_time": @"2016-03-01T12:00:00+00:00",
+             @"modified_time": @"2016-03-02T12:00:00+00:00", @"content_rating": @[@"safe"],
+             @"license": [NSNull null], @"privacy": @{@"view": @"anybody", @"embed": @"public"},
+             @"pictures": @{@"uri": @"/videos/pictures/1", @"active": @YES, @"sizes": sizes},
+             @"tags": @[@{@"name": @"luxury", @"tag": @"luxury"}, @{@"name": @"cars", @"tag": @"cars"}],
+             @"stats": @{@"plays": @(entryIdx * 10)}, @"files": files,
+             @"status": @"available"};
+}
+
+#pragma mark -
+
+
+@end
+
+#endif // DEBUG
@@ -3,13 +3,16 @@
 
 #pragma mark Class forward
 
-@class CNMVideo;
+@class CNMNetworkTransport, CNMVideo;
 
 
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- @brief  Manager which provide entry point to retrieve required data feed from remote data provider.
+ @brief      Manager which provide entry point to retrieve required data feed from remote data provider.
+ @discussion Feed state owned by private serial queue where pages is mapped and merged into feed. Main queue
+             receive immutable lists of entries and entries which has been passed with them never modified
+             asynchronously: updates applied to entry copies which replace original entries in next lists.
  
  @author Sergey Mamontov
  @since 1.0
@@ -18,6 +21,44 @@ NS_ASSUME_NONNULL_BEGIN
 @interface CNMVideoFeedManager : NSObject
 
 
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief      Stores reference on block which is called on main queue each time when information of entry which
+             already has been delivered with feed page is updated.
+ @discussion Feed pages delivered as soon as channel response has been processed and entries which arrived w/o
+             author receive it later from credits requests. Handler allow to refresh only affected entry instead
+             of whole feed. Updated entry is new instance which replace entry with same identifier.
+ */
+@property (nonatomic, nullable, copy) void(^entryUpdateHandler)(CNMVideo *video);
+
+/**
+ @brief      Stores reference on block which is called on main queue each time when entries of feed has been
+             restored from stubs or compacted to stubs.
+ @discussion Entries never compacted in place, so lists which has been delivered before keep full entries till
+             they will be replaced with passed list (which has same entries in same order).
+ */
+@property (nonatomic, nullable, copy) void(^feedUpdateHandler)(NSArray<CNMVideo *> *feed);
+
+/**
+ @brief      Stores approximate number of bytes which can be used by entries which is far from visible one.
+ @discussion Entries which doesn't fit into budget compacted to stubs which keep only identifier and idx.
+ */
+@property (nonatomic, assign) NSUInteger memoryBudget;
+
+/**
+ @brief  Stores number of entries which keep full information.
+ */
+@property (nonatomic, readonly, assign) NSUInteger residentEntriesCount;
+
+/**
+ @brief  Stores number of entries which has been compacted to stubs.
+ */
+@property (nonatomic, readonly, assign) NSUInteger stubbedEntriesCount;
+
+
 ///------------------------------------------------
 /// @name Initialization and Configuration
 ///------------------------------------------------
@@ -31,6 +72,21 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)managerWithClientAccessToken:(NSString *)token;
 
+/**
+ @brief      Create and configure manager instance which doesn't share stored feed and requests with other
+             managers.
+ @discussion Feed snapshot and records of compacted entries stored under \c name, so manager won't restore or
+             overwrite feed which has been stored by application's managers.
+ 
+ @param token     Reference on service-generated persistent access token with required access rights.
+ @param name      Name which should be used for files and directories inside of application's caches directory.
+ @param transport Reference on transport which should be used to send requests and process responses.
+ 
+ @return Configured and ready to use viedeo feed manager.
+ */
++ (instancetype)managerWithClientAccessToken:(NSString *)token storageName:(NSString *)name
+                                   transport:(CNMNetworkTransport *)transport;
+
 
 ///------------------------------------------------
 /// @name Feed data
@@ -44,7 +100,49 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)setChannelIentifier:(NSString *)identifier;
 
 /**
- @brief  Fetch latest data from video feed.
+ @brief      Restore video feed which has been stored during previous application session.
+ @discussion Stored feed is loaded from memory-mapped snapshot on state queue, so it is delivered before any
+             page which will be requested after this call. Feed still should be revalidated with
+             \c -fetchNewestFeedWithCompletion: which will merge changes into restored entries.
+ 
+ @param block Reference on block which will be called on main queue with list of restored video entries sorted
+              by \c idx (or empty list in case if there is no stored feed).
+ */
+- (void)restoreStoredFeedWithCompletion:(void(^)(NSArray<CNMVideo *> *feed))block;
+
+/**
+ @brief      Retrieve hosts from which images and videos of stored feed has been loaded.
+ @discussion Feed is loaded from snapshot which has been stored during previous application session, so method
+             should be called on background queue.
+ 
+ @return List of host names or empty list in case if there is no stored feed.
+ */
++ (NSArray<NSString *> *)hostsOfStoredFeed;
+
+/**
+ @brief      Update which entries should keep full information basing on entry which is visible to the user.
+ @discussion Entries around \c video restored from stubs and distant entries compacted to stubs if memory
+             budget is exceeded. Window updated asynchronously and feed list with restored entries and stubs
+             passed to \c feedUpdateHandler. Stubs doesn't have information which can be shown, so entries from
+             this list should be passed through \c -prepareEntryForDisplay: before they will be shown.
+ 
+ @param video Reference on video entry which is visible to the user.
+ */
+- (void)updateResidentEntriesAroundEntry:(CNMVideo *)video;
+
+/**
+ @brief      Make sure what entry has full information and can be shown to the user.
+ @discussion Stub restored asynchronously to copy which replace it in feed and passed to
+             \c entryUpdateHandler.
+ 
+ @param video Reference on video entry which will be shown.
+ */
+- (void)prepareEntryForDisplay:(CNMVideo *)video;
+
+/**
+ @brief      Fetch latest data from video feed.
+ @discussion If feed already has entries, only entries which has been added after newest known entry fetched
+             (with small pages which grow till known entry will be found) and merged at the head of the feed.
  
  @param block Reference on block which should be called at the end of fetching process. Block pass array of 
               video entry instances or error instance.
@@ -53,21 +151,50 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  @brief      Fetch next portion of data from video feed.
- @discussion This feature is possible when remote data provier support pagination.
+ @discussion This feature is possible when remote data provier support pagination. Manager keep few next pages
+             requests active at once (as much as network connections allow), so \c block will be called as
+             soon as next page arrive and merged into feed while following pages still fetching.
  
  @param block Reference on block which should be called at the end of fetching process. Block pass array of 
               video entry instances or error instance.
  */
 - (void)fetchNextFeedPageWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError * _Nullable error))block;
 
+/**
+ @brief      Raise priority of next feed page request because user already reached the end of the feed.
+ @discussion Next feed pages requested ahead of time with prefetch priority and may wait while more important
+             requests will be completed.
+ */
+- (void)prioritizeNextFeedPageFetch;
+
+/**
+ @brief      Cancel next feed page fetch which has been started with \c -fetchNextFeedPageWithCompletion:.
+ @discussion Fetch of latest data won't be affected. Completion block of cancelled fetch will be called with
+             list of already stored video entries.
+ */
+- (void)cancelNextFeedPageFetch;
+
+/**
+ @brief      Prefetch video file presets for entry which is shown to the user and entry which follow it.
+ @discussion Feed pages doesn't include video file presets, so they fetched only for entries which can be
+             played soon. If user start playback while presets is fetching, playback request share it's
+             response.
+ 
+ @param video Reference on video entry which is shown to the user.
+ */
+- (void)prefetchPresetsAroundEntry:(CNMVideo *)video;
+
 /**
  @brief      Fetch updates for video feed entry by request.
- @discussion Method can be used to receive data in case if previously video was in \c transcoding state.
+ @discussion Method should be used to receive video file presets if they hasn't been prefetched yet or if
+             previously video was in \c transcoding state. Entry which has been delivered with feed won't be
+             modified. Updated copy replace it in feed and passed to \c entryUpdateHandler.
  
  @param video Reference on video entry data model for which data should be pulled out.
- @param block Reference on block which should be called at the end of data fetching process.
+ @param block Reference on block which should be called at the end of data fetching process. Block pass
+              updated entry copy (or \c video in case if data fetch failed).
  */
-- (void)fetchAndUpdateDataForVideo:(CNMVideo *)video withCompletion:(dispatch_block_t)block;
+- (void)fetchAndUpdateDataForVideo:(CNMVideo *)video withCompletion:(void(^)(CNMVideo *video))block;
 
 #pragma mark -
 
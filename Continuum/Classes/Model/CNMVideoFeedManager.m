@@ -5,19 +5,57 @@
  */
 #import "CNMVideoFeedManager.h"
 #import "CNMVimeoChannelVideosRequest.h"
-#import "CNMVimeoVideoCreditsRequest.h"
 #import "CNMVimeoVideoRequest.h"
 #import "NSArray+CNMAdditions.h"
+#import "CNMVideoFeedPageSizePolicy.h"
+#import "CNMVideoCreditsLoader.h"
+#import "CNMVideoFeedSnapshot.h"
+#import "CNMVideoFeedWindow.h"
+#import "CNMVideoFeedIndex.h"
 #import "CNMVideo+Private.h"
+#import "CNMVideoPreset.h"
+#import "CNMVideoDecoder.h"
+#import "CNMNetworkTransport.h"
 #import "CNMNetorkManager.h"
 
 
 #pragma mark Static
 
 /**
- @brief  Stores how many entries should be fecthed at once.
+ @brief  Stores how many credits requests for entries w/o author can be active at once.
  */
-static NSInteger const kCNMMaximumEntriesPerRequest = 5;
+static NSUInteger const kCNMMaximumConcurrentCreditsRequests = 2;
+
+/**
+ @brief  Stores how many newest entries requested to check whether feed has new entries.
+ */
+static NSUInteger const kCNMDeltaSyncPageSize = 5;
+
+/**
+ @brief      Stores how many newest entries can be walked to find known entry.
+ @discussion If there is more new entries, first feed page fetched as for empty feed.
+ */
+static NSUInteger const kCNMMaximumDeltaSyncEntries = 80;
+
+/**
+ @brief  Stores reference on name of file in which video feed snapshot is stored.
+ */
+static NSString * const kCNMFeedSnapshotName = @"com.continuumluxury.continuum.feed";
+
+/**
+ @brief  Stores reference on name of directory in which records of compacted video entries is stored.
+ */
+static NSString * const kCNMFeedWindowName = @"com.continuumluxury.continuum.feed.window";
+
+/**
+ @brief  Stores for how many entries (starting from shown one) video file presets fetched ahead of playback.
+ */
+static NSUInteger const kCNMPresetsPrefetchEntriesCount = 2;
+
+/**
+ @brief  Stores for how long (in seconds) changes of feed state collected before they will be written into snapshot.
+ */
+static NSTimeInterval const kCNMSnapshotStoreDelay = 0.5f;
 
 
 #pragma mark - Private interface declaration
@@ -27,6 +65,12 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 
 #pragma mark - Properties
 
+/**
+ @brief      Stores reference on serial queue which own feed state.
+ @discussion Pagination, active requests, entries index and window accessed only from this queue.
+ */
+@property (nonatomic) dispatch_queue_t stateQueue;
+
 /**
  @brief  Stores reference on string which is used to authorize with remote service.
  */
@@ -44,10 +88,20 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 @property (nonatomic, copy) NSString *channelIdentifier;
 
 /**
- @brief  Stores reference on current page for which data has been fetched or will be fetched with next 
-         request.
+ @brief  Stores reference on next page URI which has been provided by remote data provider with last page in
+         pagination chain (\c nil in case if there is no more pages or chain not started yet).
  */
-@property (nonatomic, assign) NSUInteger currentPage;
+@property (nonatomic, copy) NSString *nextPageCursor;
+
+/**
+ @brief  Stores number of feed entries (from newest) which precede page referenced by \c nextPageCursor.
+ */
+@property (nonatomic, assign) NSUInteger nextPageOffset;
+
+/**
+ @brief  Stores reference on policy which decide how many entries should be requested with next page.
+ */
+@property (nonatomic) CNMVideoFeedPageSizePolicy *pageSizePolicy;
 
 /**
  @brief  Stores whether client requesting first page with latest video entries.
@@ -55,10 +109,52 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 @property (nonatomic, assign) BOOL fetchingFreshPage;
 
 /**
- @brief  Stores reference on currently active network request.
+ @brief  Stores reference on currently active first feed page request.
  */
 @property (nonatomic) CNMVimeoChannelVideosRequest *currentRequest;
 
+/**
+ @brief  Stores maximum number of next feed page requests which can be active at once.
+ */
+@property (nonatomic, assign) NSUInteger maximumConcurrentPageRequests;
+
+/**
+ @brief  Stores number of feed entries (from newest) which precede page which will be requested next (include
+         entries from pages which still fetching).
+ */
+@property (nonatomic, assign) NSUInteger requestedPageOffset;
+
+/**
+ @brief  Stores sequence number which will be assigned to next feed page request.
+ */
+@property (nonatomic, assign) NSUInteger nextPageSequence;
+
+/**
+ @brief  Stores sequence number of next feed page which should be merged into feed.
+ */
+@property (nonatomic, assign) NSUInteger mergedPageSequence;
+
+/**
+ @brief  Stores reference on dictionary where each key is page sequence number and value is active request.
+ */
+@property (nonatomic) NSMutableDictionary<NSNumber *, CNMVimeoChannelVideosRequest *> *pageRequests;
+
+/**
+ @brief  Stores reference on dictionary where each key is page sequence number and value is page which arrived
+         before pages which precede it (remote data provider response or request error).
+ */
+@property (nonatomic) NSMutableDictionary<NSNumber *, id> *receivedPages;
+
+/**
+ @brief  Stores reference on blocks which wait for next feed page merge.
+ */
+@property (nonatomic) NSMutableArray<void(^)(NSArray<CNMVideo *> *, NSError *)> *pageCompletionBlocks;
+
+/**
+ @brief  Stores whether some pages has been merged into feed when there was no blocks which wait for them.
+ */
+@property (nonatomic, assign) BOOL hasUndeliveredPages;
+
 /**
  @brief  Stores whether remote data provider is able to provide more pages with data or not.
  */
@@ -70,10 +166,29 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 @property (nonatomic, assign) NSUInteger totalEntriesCount;
 
 /**
- @brief  Stores reference on dictionary where each entry is video identifier and value is video model 
-         instance.
+ @brief  Stores reference on index which keep video model instances sorted by \c idx.
+ */
+@property (nonatomic) CNMVideoFeedIndex *entries;
+
+/**
+ @brief  Stores reference on loader which fetch credits for entries which arrived w/o author information.
  */
-@property (nonatomic) NSMutableDictionary<NSString *, CNMVideo *> *entries;
+@property (nonatomic) CNMVideoCreditsLoader *creditsLoader;
+
+/**
+ @brief  Stores reference on persistent video feed snapshot which allow to show feed right after launch.
+ */
+@property (nonatomic) CNMVideoFeedSnapshot *snapshot;
+
+/**
+ @brief  Stores whether feed state changed and write into persistent snapshot already scheduled or not.
+ */
+@property (nonatomic, assign, getter = isSnapshotStoreScheduled) BOOL snapshotStoreScheduled;
+
+/**
+ @brief  Stores reference on window which keep full information only for entries around visible one.
+ */
+@property (nonatomic) CNMVideoFeedWindow *window;
 
 
 #pragma mark - Initialization and Configuration
@@ -81,69 +196,201 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 /**
  @brief  Initialize manager instance to operate with predefined configuration.
 
- @param token Reference on service-generated persistent access token with required access rights.
+ @param token        Reference on service-generated persistent access token with required access rights.
+ @param snapshotName Name of file in which video feed snapshot should be stored.
+ @param windowName   Name of directory in which records of compacted video entries should be stored.
+ @param transport    Reference on transport which should be used to send requests and process responses.
  
  @return Configured and ready to use viedeo feed manager.
  */
-- (instancetype)initWithClientAccessToken:(NSString *)token;
+- (instancetype)initWithClientAccessToken:(NSString *)token snapshotName:(NSString *)snapshotName
+                               windowName:(NSString *)windowName transport:(CNMNetworkTransport *)transport;
 
 
 #pragma mark - Feed data
 
 /**
- @brief  Retrieve list of vieo entries which is available at current page.
+ @brief  Retrieve list of vieo entries which is available at requested page.
  
- @param identifier Reference on ientifier of the channel from which list of videos should be downloaded. This
-                   also can be URI from user's information request.
- @param block      Reference on block which will be called as soon as all videos will be retrieved.
+ @param request Reference on request which describe feed page which should be retrieved.
+ @param block   Reference on block which will be called as soon as page will be retrieved.
+ 
+ @return Active request instance.
  */
-- (void)fetchFeedWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
+- (CNMVimeoChannelVideosRequest *)fetchFeedWithRequest:(CNMVimeoChannelVideosRequest *)request
+                                            completion:(void(^)(id JSONObject, NSError *error))block;
 
 /**
- @brief  Handle data fetch request completion.
+ @brief  Fetch first feed page and merge it into feed.
+ 
+ @param block Reference on block which should be called at the end of fetching process.
+ */
+- (void)fetchFreshPageWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
+
+/**
+ @brief      Fetch feed page with entries which may be added after newest known entry.
+ @discussion Each next page twice as large as all pages before it, so page start is always addressable with
+             it's size.
+ 
+ @param offset       Number of feed entries (from newest) which precede requested page.
+ @param pageSize     How many entries should be requested.
+ @param addedEntries Reference on list of new entries which has been found on previous pages.
+ @param block        Reference on block which should be called at the end of fetching process.
+ */
+- (void)fetchEntriesAddedAtOffset:(NSUInteger)offset pageSize:(NSUInteger)pageSize
+                     addedEntries:(NSMutableArray<CNMVideo *> *)addedEntries
+                       completion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
+
+/**
+ @brief      Start next feed page requests while there is free slots.
+ @discussion Page which follow last merged page requested with cursor which has been provided by remote data
+             provider. Pages after it requested with same size, so each of them start right after previous.
+ */
+- (void)startNextPageRequests;
+
+/**
+ @brief  Stop all next feed page requests and forget pages which wait for merge.
+ */
+- (void)resetNextPageRequests;
+
+/**
+ @brief  Stop all next feed page requests and pass current feed state to blocks which wait for them.
+ */
+- (void)cancelNextPageRequests;
+
+/**
+ @brief  Fetch video file presets for feed entry.
+ 
+ @param video    Reference on video entry data model for which presets should be pulled out.
+ @param priority Priority with which request should be sent.
+ @param block    Reference on block which should be called on main queue at the end of data fetching process.
+ */
+- (void)fetchPresetsForVideo:(CNMVideo *)video withPriority:(CNMRequestPriority)priority
+                  completion:(void(^)(CNMVideo *video))block;
+
+/**
+ @brief      Handle data fetch request completion.
+ @discussion Response shuffled, mapped and merged into feed on state queue.
  
  @param data  Reference on instance which store remote data provider response.
  @param error Stores reference on request processing error.
- @param block Reference on block which will be called as soon as all videos will be retrieved.
+ @param block Reference on block which will be called on state queue as soon as all videos will be retrieved.
  */
 - (void)handleFeedResponse:(NSDictionary *)data withError:(NSError *)error 
                 completion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
 
+/**
+ @brief      Handle completion of page request which has been sent to find new entries.
+ @discussion Page walked till first known entry. If it hasn't been found, next page requested. New entries
+             receive \c idx above newest known entry and merged at the head of the feed.
+ 
+ @param data         Reference on instance which store remote data provider response.
+ @param error        Stores reference on request processing error.
+ @param offset       Number of feed entries (from newest) which precede received page.
+ @param pageSize     How many entries has been requested.
+ @param addedEntries Reference on list of new entries which has been found on previous pages.
+ @param block        Reference on block which should be called at the end of fetching process.
+ */
+- (void)handleDeltaResponse:(NSDictionary *)data withError:(NSError *)error atOffset:(NSUInteger)offset
+                   pageSize:(NSUInteger)pageSize addedEntries:(NSMutableArray<CNMVideo *> *)addedEntries
+                 completion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
+
+/**
+ @brief      Handle next feed page request completion.
+ @discussion Pages can arrive in any order, but merged into feed strictly in order in which they has been
+             requested, so entries always receive same \c idx.
+ 
+ @param request  Reference on request which has been completed.
+ @param sequence Page sequence number.
+ @param data     Reference on instance which store remote data provider response.
+ @param error    Stores reference on request processing error.
+ */
+- (void)handlePageRequest:(CNMVimeoChannelVideosRequest *)request withSequence:(NSUInteger)sequence
+       completionWithData:(NSDictionary *)data error:(NSError *)error;
+
+/**
+ @brief      Pass current feed state to all blocks which wait for next feed page merge.
+ @discussion If there is no blocks, feed state will be passed to the block which will be passed with next
+             \c -fetchNextFeedPageWithCompletion: call.
+ 
+ @param error Reference on next feed page fetch error (if any).
+ */
+- (void)completeNextPageFetchesWithError:(NSError *)error;
+
 /**
  @brief  Handle data parsing completion.
  
  @param videos Reference on list of entries which has been parsed and stored in local cache.
- @param block  Reference on block which will be called as soon as all videos will be retrieved.
+ @param block  Reference on block which will be called on state queue as soon as all videos will be retrieved.
  */
 - (void)handleParseCompletion:(NSArray<CNMVideo *> *)videos 
                withCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
 
 /**
- @brief  Handle video data fetch request completion.
+ @brief      Handle credits fetch completion.
+ @discussion Entry which has been passed to main queue with feed snapshot won't be modified. Credits applied to
+             it's copy which replace entry in feed.
+ 
+ @param credits Reference on list of video credits.
+ @param video   Reference on video entry for which credits has been requested.
+ */
+- (void)handleCredits:(NSArray<NSDictionary<NSString *, id> *> *)credits forEntry:(CNMVideo *)video;
+
+/**
+ @brief      Handle video data fetch request completion.
+ @discussion Entry which has been passed to main queue with feed snapshot won't be modified. Fetched data
+             applied to it's copy which replace entry in feed.
  
  @param data  Reference on instance which store remote data provider response.
- @param error Stores reference on request processing error.
- @param block Reference on block which will be called as soon as video data will be retrieved.
+ @param video Reference on video entry for which data has been requested.
+ 
+ @return Updated entry copy or \c nil in case if response doesn't have video data.
  */
-- (void)handleVideoResponse:(NSDictionary *)data withError:(NSError *)error 
-                 completion:(void(^)(CNMVideo *video))block;
+- (CNMVideo *)handleVideoResponse:(NSDictionary *)data forEntry:(CNMVideo *)video;
 
 
 #pragma mark - Misc
 
 /**
- @brief  Use gathered video entries information to create sorted list of entries.
+ @brief      Pass feed state to the block on main queue.
+ @discussion Only ready to use immutable list passed to main queue and time which block spent there is logged
+             in debug builds.
  
- @return List of \b CNMVideo entries sorted by \c idx field.
+ @param feed  Reference on list of video entries sorted by \c idx.
+ @param error Reference on feed fetch error (if any).
+ @param block Reference on block which should receive feed state.
  */
-- (NSArray<CNMVideo *> *)sortedEntries;
+- (void)deliverFeed:(NSArray<CNMVideo *> *)feed withError:(NSError *)error
+            toBlock:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block;
 
 /**
- @brief  Calculate next request page basing on information stored in cache.
+ @brief      Schedule store of current video feed state into persistent snapshot.
+ @discussion Changes which arrive during \c kCNMSnapshotStoreDelay seconds written into snapshot at once.
+ */
+- (void)storeSnapshot;
+
+/**
+ @brief  Write current video feed state into persistent snapshot.
+ */
+- (void)flushSnapshot;
+
+/**
+ @brief      Update pagination chain with information from received feed page.
+ @discussion Chain only move forward, so first page which has been fetched to check for new entries won't
+             move it back to the beginning of the feed.
+ 
+ @param data Reference on instance which store remote data provider response.
+ */
+- (void)updatePaginationWithResponse:(NSDictionary *)data;
+
+/**
+ @brief      Move pagination chain to the page which contain first not stored entry.
+ @discussion New entries shift pages on remote data provider, so cursor re-built for page which start at or
+             before first not stored entry (overlapping entries dropped when page will be merged).
  
- @return Index of next page for which data should be retrieved.
+ @param count How many new entries has been merged at the head of the feed.
  */
-- (NSUInteger)nextPageIndex;
+- (void)shiftPaginationByEntriesCount:(NSUInteger)count;
 
 #pragma mark -
 
@@ -156,24 +403,89 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 @implementation CNMVideoFeedManager
 
 
+#pragma mark - Information
+
+- (NSUInteger)memoryBudget {
+    
+    __block NSUInteger memoryBudget = 0;
+    dispatch_sync(self.stateQueue, ^{ memoryBudget = self.window.memoryBudget; });
+    
+    return memoryBudget;
+}
+
+- (void)setMemoryBudget:(NSUInteger)memoryBudget {
+    
+    dispatch_async(self.stateQueue, ^{ self.window.memoryBudget = memoryBudget; });
+}
+
+- (NSUInteger)residentEntriesCount {
+    
+    __block NSUInteger residentEntriesCount = 0;
+    dispatch_sync(self.stateQueue, ^{ residentEntriesCount = self.window.residentEntriesCount; });
+    
+    return residentEntriesCount;
+}
+
+- (NSUInteger)stubbedEntriesCount {
+    
+    __block NSUInteger stubbedEntriesCount = 0;
+    dispatch_sync(self.stateQueue, ^{ stubbedEntriesCount = self.window.stubbedEntriesCount; });
+    
+    return stubbedEntriesCount;
+}
+
+
 #pragma mark - Initialization and Configuration
 
 + (instancetype)managerWithClientAccessToken:(NSString *)token {
     
-    return [[self alloc] initWithClientAccessToken:token];
+    return [[self alloc] initWithClientAccessToken:token snapshotName:kCNMFeedSnapshotName
+                                        windowName:kCNMFeedWindowName
+                                         transport:[CNMNetworkTransport sharedTransport]];
+}
+
++ (instancetype)managerWithClientAccessToken:(NSString *)token storageName:(NSString *)name
+                                   transport:(CNMNetworkTransport *)transport {
+    
+    return [[self alloc] initWithClientAccessToken:token snapshotName:name
+                                        windowName:[name stringByAppendingPathExtension:@"window"]
+                                         transport:transport];
 }
 
-- (instancetype)initWithClientAccessToken:(NSString *)token {
+- (instancetype)initWithClientAccessToken:(NSString *)token snapshotName:(NSString *)snapshotName
+                               windowName:(NSString *)windowName transport:(CNMNetworkTransport *)transport {
     
     // Check whether initialization was successful or not.
     if ((self = [super init])) {
         
         _clientAccessToken = [token copy];
-        _entries = [NSMutableDictionary new];
+        _stateQueue = dispatch_queue_create("com.continuumluxury.continuum.feed.state", DISPATCH_QUEUE_SERIAL);
+        _entries = [CNMVideoFeedIndex index];
         _hasMorePages = YES;
+        _pageSizePolicy = [CNMVideoFeedPageSizePolicy policy];
+        _pageRequests = [NSMutableDictionary new];
+        _receivedPages = [NSMutableDictionary new];
+        _pageCompletionBlocks = [NSMutableArray new];
+        _snapshot = [CNMVideoFeedSnapshot snapshotWithName:snapshotName];
+        _window = [CNMVideoFeedWindow windowWithName:windowName];
         [CNMVimeoChannelVideosRequest setAccessToken:token];
         [CNMVimeoRequest setAccessToken:token];
-        self.networkManager = [CNMNetorkManager new];
+        self.networkManager = [CNMNetorkManager managerWithTransport:transport];
+        self.networkManager.HTTPHeaders = @{@"Authorization": [NSString stringWithFormat:@"Bearer %@", token]};
+        
+        // Connections which isn't used by credits requests shared between next feed page requests.
+        NSUInteger connectionsCount = self.networkManager.maximumConcurrentRequests;
+        self.maximumConcurrentPageRequests = (connectionsCount > kCNMMaximumConcurrentCreditsRequests + 1 ?
+                                              connectionsCount - kCNMMaximumConcurrentCreditsRequests : 1);
+        self.creditsLoader = [CNMVideoCreditsLoader loaderWithNetworkManager:self.networkManager
+                                                   maximumConcurrentRequests:kCNMMaximumConcurrentCreditsRequests
+                                                                       queue:_stateQueue];
+        
+        __weak __typeof__(self) weakSelf = self;
+        self.creditsLoader.updateHandler = ^(CNMVideo *video, NSArray<NSDictionary<NSString *, id> *> *credits) {
+            
+            [weakSelf handleCredits:credits forEntry:video];
+        };
     }
     
     return self;
@@ -184,64 +496,325 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
 
 - (void)setChannelIentifier:(NSString *)identifier {
     
-    self.channelIdentifier = identifier;
+    dispatch_async(self.stateQueue, ^{ self.channelIdentifier = identifier; });
 }
 
-- (void)fetchNewestFeedWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError * _Nullable error))block {
-
-    if (!self.fetchingFreshPage && self.currentRequest) {
+- (void)restoreStoredFeedWithCompletion:(void(^)(NSArray<CNMVideo *> *feed))block {
+    
+    dispatch_async(self.stateQueue, ^{
         
-        [self.networkManager cancelRequest:self.currentRequest];
-        self.currentRequest = nil;
-    }
+        NSUInteger totalEntriesCount = 0;
+        NSArray<CNMVideo *> *videos = [self.snapshot loadEntriesWithTotalEntriesCount:&totalEntriesCount];
+        if (videos.count && self.entries.count == 0) {
+            
+            self.totalEntriesCount = totalEntriesCount;
+            for (CNMVideo *video in videos) { [self.entries addEntry:video]; }
+            [self.creditsLoader loadCreditsForVideos:self.entries.snapshot];
+#if DEBUG
+            NSLog(@"<Continuum::Snapshot> Restored %lu entries from %llu bytes in %.2f ms",
+                  (unsigned long)self.entries.count, self.snapshot.size, self.snapshot.loadDuration * 1000.0f);
+#endif
+        }
+        NSArray<CNMVideo *> *feed = self.entries.snapshot;
+        dispatch_async(dispatch_get_main_queue(), ^{ block(feed); });
+    });
+}
+
++ (NSArray<NSString *> *)hostsOfStoredFeed {
     
-    if (!self.currentRequest) {
+    NSUInteger totalEntriesCount = 0;
+    CNMVideoFeedSnapshot *snapshot = [CNMVideoFeedSnapshot snapshotWithName:kCNMFeedSnapshotName];
+    NSMutableOrderedSet<NSString *> *hosts = [NSMutableOrderedSet new];
+    for (CNMVideo *video in [snapshot loadEntriesWithTotalEntriesCount:&totalEntriesCount]) {
         
-        self.currentPage = 1;
-        [self fetchFeedWithCompletion:block];
+        NSString *imageHost = (video.imagePath ? [NSURL URLWithString:video.imagePath].host : nil);
+        if (imageHost) { [hosts addObject:imageHost]; }
+        for (CNMVideoPreset *preset in video.presets) {
+            
+            NSString *videoHost = [NSURL URLWithString:preset.url].host;
+            if (videoHost) { [hosts addObject:videoHost]; }
+        }
     }
+    
+    return hosts.array;
 }
 
-- (void)fetchNextFeedPageWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError * _Nullable error))block {
+- (void)updateResidentEntriesAroundEntry:(CNMVideo *)video {
     
-    if (self.hasMorePages) {
+    dispatch_async(self.stateQueue, ^{
         
-        self.currentPage = [self nextPageIndex];
-        [self fetchFeedWithCompletion:block];
-    }
-    else { dispatch_async(dispatch_get_main_queue(), ^{ block([self sortedEntries], nil); }); }
+        // Passed entry may be replaced with copy since it has been delivered.
+        CNMVideo *storedVideo = [self.entries entryWithIdentifier:video.identifier];
+        NSUInteger index = (storedVideo ? [self.entries indexOfEntry:storedVideo] : NSNotFound);
+        if (index == NSNotFound) { return; }
+        
+        NSArray<CNMVideo *> *entries = self.entries.snapshot;
+        NSArray<CNMVideo *> *updatedEntries = [self.window updateEntries:entries aroundIndex:index];
+        BOOL entriesReplaced = NO;
+        for (NSUInteger entryIdx = 0; entryIdx < entries.count; entryIdx++) {
+            
+            if (updatedEntries[entryIdx] != entries[entryIdx]) {
+                
+                [self.entries replaceEntry:entries[entryIdx] withEntry:updatedEntries[entryIdx]];
+                entriesReplaced = YES;
+            }
+        }
+#if DEBUG
+        NSLog(@"<Continuum::Window> %lu resident and %lu stubbed entries",
+              (unsigned long)self.window.residentEntriesCount, (unsigned long)self.window.stubbedEntriesCount);
+#endif
+        void(^handler)(NSArray<CNMVideo *> *) = self.feedUpdateHandler;
+        if (handler && entriesReplaced) {
+            
+            NSArray<CNMVideo *> *feed = self.entries.snapshot;
+            dispatch_async(dispatch_get_main_queue(), ^{ handler(feed); });
+        }
+    });
 }
 
-- (void)fetchFeedWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block {
+- (void)prepareEntryForDisplay:(CNMVideo *)video {
     
-    CNMVimeoChannelVideosRequest *request = [CNMVimeoChannelVideosRequest requestForChannel:self.channelIdentifier
-                                             toFetch:kCNMMaximumEntriesPerRequest withPageOffset:self.currentPage];
-    self.fetchingFreshPage = (self.currentPage == 1);
+    if (!video.isStub) { return; }
+    
+    dispatch_async(self.stateQueue, ^{
+        
+        // Entry may be restored or removed since stub has been delivered.
+        CNMVideo *storedVideo = [self.entries entryWithIdentifier:video.identifier];
+        CNMVideo *restoredVideo = [self.window restoredEntry:(storedVideo ?: video)];
+        if (restoredVideo.isStub) { return; }
+        
+        if (storedVideo && restoredVideo != storedVideo) {
+            
+            [self.entries replaceEntry:storedVideo withEntry:restoredVideo];
+        }
+        void(^handler)(CNMVideo *) = self.entryUpdateHandler;
+        if (handler) { dispatch_async(dispatch_get_main_queue(), ^{ handler(restoredVideo); }); }
+    });
+}
+
+- (void)fetchNewestFeedWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError * _Nullable error))block {
 
-    __block __weak typeof(self) weakSelf = self;
-    self.currentRequest = [self.networkManager fetchJSONWithRequest:request 
-                                                    completionBlock:^(id JSONObject, NSError *error) {
+    dispatch_async(self.stateQueue, ^{
+        
+        // Older pages merged after first page will receive wrong \c idx, so they fetched again later.
+        [self cancelNextPageRequests];
+        if (!self.currentRequest) {
+            
+            __weak __typeof__(self) weakSelf = self;
+            void(^fetchBlock)(NSArray<CNMVideo *> *, NSError *) = ^(NSArray<CNMVideo *> *feed, NSError *error) {
+                
+                [weakSelf deliverFeed:feed withError:error toBlock:block];
+            };
+            
+            // Known feed only checked for entries which has been added after it's newest entry.
+            if (self.entries.count) {
+                
+                [self fetchEntriesAddedAtOffset:0 pageSize:kCNMDeltaSyncPageSize
+                                   addedEntries:[NSMutableArray new] completion:fetchBlock];
+            }
+            else { [self fetchFreshPageWithCompletion:fetchBlock]; }
+        }
+    });
+}
 
-        __block __strong typeof(self) strongSelf = weakSelf;
+- (void)fetchFreshPageWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block {
+    
+    NSString *channel = self.channelIdentifier;
+    NSUInteger pageSize = [self.pageSizePolicy pageSizeForOffset:0];
+    CNMVimeoChannelVideosRequest *request = [CNMVimeoChannelVideosRequest requestForChannel:channel
+                                                                                   toFetch:pageSize
+                                                                            withPageOffset:1];
+    self.fetchingFreshPage = YES;
+    __weak __typeof__(self) weakSelf = self;
+    self.currentRequest = [self fetchFeedWithRequest:request completion:^(id JSONObject, NSError *error) {
+        
+        __typeof__(weakSelf) strongSelf = weakSelf;
+        
+        // Cancelled request completion can arrive after next request has been started.
+        if (strongSelf.currentRequest != request) { return; }
+        
         strongSelf.currentRequest = nil;
         [strongSelf handleFeedResponse:JSONObject withError:error completion:block];
         strongSelf.fetchingFreshPage = NO;
     }];
 }
 
-- (void)fetchAndUpdateDataForVideo:(CNMVideo *)video withCompletion:(dispatch_block_t)block {
-    
-    CNMVimeoVideoRequest *request = [CNMVimeoVideoRequest requestForVideo:video];
+- (void)fetchEntriesAddedAtOffset:(NSUInteger)offset pageSize:(NSUInteger)pageSize
+                     addedEntries:(NSMutableArray<CNMVideo *> *)addedEntries
+                       completion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block {
     
+    CNMVimeoChannelVideosRequest *request = [CNMVimeoChannelVideosRequest requestForChannel:self.channelIdentifier
+                                                                                   toFetch:pageSize
+                                                                            withPageOffset:(offset / pageSize + 1)];
     __weak __typeof__(self) weakSelf = self;
-    [self.networkManager fetchJSONWithRequest:request completionBlock:^(id JSONObject, NSError *error) {
+    self.currentRequest = [self fetchFeedWithRequest:request completion:^(id JSONObject, NSError *error) {
         
         __typeof__(weakSelf) strongSelf = weakSelf;
-        [strongSelf handleVideoResponse:JSONObject withError:error completion:^(CNMVideo *upatedVideo) {
+        
+        // Cancelled request completion can arrive after next request has been started.
+        if (strongSelf.currentRequest != request) { return; }
+        
+        strongSelf.currentRequest = nil;
+        [strongSelf handleDeltaResponse:JSONObject withError:error atOffset:offset pageSize:pageSize
+                           addedEntries:addedEntries completion:block];
+    }];
+}
+
+- (void)fetchNextFeedPageWithCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError * _Nullable error))block {
+    
+    dispatch_async(self.stateQueue, ^{
+        
+        if (self.hasMorePages && self.nextPageCursor && !self.currentRequest) {
+            
+            [self.pageCompletionBlocks addObject:[block copy]];
+            [self startNextPageRequests];
+            
+            // Pages which has been merged earlier not delivered yet or requested pages is beyond the end of the
+            // feed.
+            if (self.hasUndeliveredPages || (self.pageRequests.count == 0 && self.receivedPages.count == 0)) {
+                
+                [self completeNextPageFetchesWithError:nil];
+            }
+        }
+        else {
+            
+            [self deliverFeed:self.entries.snapshot withError:nil toBlock:block];
+        }
+    });
+}
+
+- (void)prioritizeNextFeedPageFetch {
+    
+    dispatch_async(self.stateQueue, ^{
+        
+        // Only page which will be merged next is waited by the user.
+        CNMVimeoChannelVideosRequest *request = self.pageRequests[@(self.mergedPageSequence)];
+        if (request) { [self.networkManager updatePriority:CNMRequestVisiblePriority forRequest:request]; }
+    });
+}
+
+- (void)cancelNextFeedPageFetch {
+    
+    dispatch_async(self.stateQueue, ^{ [self cancelNextPageRequests]; });
+}
+
+- (void)startNextPageRequests {
+    
+    if (self.requestedPageOffset < self.nextPageOffset) { self.requestedPageOffset = self.nextPageOffset; }
+    if (self.pageRequests.count >= self.maximumConcurrentPageRequests) { return; }
+    
+    NSUInteger pageSize = 0;
+    while (self.pageRequests.count < self.maximumConcurrentPageRequests &&
+           (self.totalEntriesCount == 0 || self.requestedPageOffset < self.totalEntriesCount)) {
+        
+        // Page which follow last merged page fetched strictly by cursor. Cursors of pages after it not known
+        // yet, so they addressed with size which is picked by policy once per batch.
+        NSUInteger offset = self.requestedPageOffset;
+        CNMVimeoChannelVideosRequest *request = nil;
+        if (self.nextPageCursor && offset == self.nextPageOffset) {
+            
+            request = [CNMVimeoChannelVideosRequest requestWithCursor:self.nextPageCursor];
+        }
+        else {
             
-            if (upatedVideo) { [video updateWithVideo:upatedVideo]; }
-            block();
+            if (pageSize == 0) { pageSize = [self.pageSizePolicy pageSizeForOffset:offset]; }
+            request = [CNMVimeoChannelVideosRequest requestForChannel:self.channelIdentifier toFetch:pageSize
+                                                       withPageOffset:(offset / pageSize + 1)];
+        }
+        
+        // Next pages requested ahead of time while user is watching already fetched entries.
+        request.priority = CNMRequestPrefetchPriority;
+        NSUInteger sequence = self.nextPageSequence++;
+        self.requestedPageOffset += request.numberOfEntries;
+        self.pageRequests[@(sequence)] = request;
+        
+        __weak __typeof__(self) weakSelf = self;
+        [self fetchFeedWithRequest:request completion:^(id JSONObject, NSError *error) {
+            
+            [weakSelf handlePageRequest:request withSequence:sequence completionWithData:JSONObject error:error];
         }];
+    }
+}
+
+- (void)resetNextPageRequests {
+    
+    NSArray<CNMVimeoChannelVideosRequest *> *requests = self.pageRequests.allValues;
+    [self.pageRequests removeAllObjects];
+    [self.receivedPages removeAllObjects];
+    self.mergedPageSequence = self.nextPageSequence;
+    self.requestedPageOffset = self.nextPageOffset;
+    for (CNMVimeoChannelVideosRequest *request in requests) { [self.networkManager cancelRequest:request]; }
+}
+
+- (void)cancelNextPageRequests {
+    
+    [self resetNextPageRequests];
+    if (self.pageCompletionBlocks.count) { [self completeNextPageFetchesWithError:nil]; }
+}
+
+- (CNMVimeoChannelVideosRequest *)fetchFeedWithRequest:(CNMVimeoChannelVideosRequest *)request
+                                            completion:(void(^)(id JSONObject, NSError *error))block {
+
+    // Entries decoded on background queue while channel response is still arriving.
+    CNMVideoDecoder *videoDecoder = [CNMVideoDecoder decoder];
+    id(^decoder)(NSData *) = ^id(NSData *elementData) { return [videoDecoder videoFromData:elementData]; };
+    CFAbsoluteTime requestDate = CFAbsoluteTimeGetCurrent();
+    __weak __typeof__(self) weakSelf = self;
+    
+    // Response delivered right to the state queue where it will be merged into feed.
+    return [self.networkManager fetchJSONWithRequest:request elementDecoder:decoder callbackQueue:self.stateQueue
+                                     completionBlock:^(id JSONObject, NSError *error) {
+
+        if (JSONObject && !error) {
+            
+            NSUInteger pageSize = ((NSNumber *)JSONObject[@"per_page"]).unsignedIntegerValue;
+            [weakSelf.pageSizePolicy recordPageOfSize:pageSize
+                                   fetchedWithLatency:(CFAbsoluteTimeGetCurrent() - requestDate)];
+        }
+        block(JSONObject, error);
+    }];
+}
+
+- (void)prefetchPresetsAroundEntry:(CNMVideo *)video {
+    
+    dispatch_async(self.stateQueue, ^{
+        
+        NSArray<CNMVideo *> *feed = self.entries.snapshot;
+        CNMVideo *storedVideo = [self.entries entryWithIdentifier:video.identifier];
+        NSUInteger index = (storedVideo ? [self.entries indexOfEntry:storedVideo] : NSNotFound);
+        if (index == NSNotFound) { return; }
+        
+        // Compacted entries is outside of window around shown entry and presets will be restored along with
+        // other entry information.
+        NSRange range = NSMakeRange(index, MIN(kCNMPresetsPrefetchEntriesCount, feed.count - index));
+        for (CNMVideo *entry in [feed subarrayWithRange:range]) {
+            
+            if (!entry.isStub && entry.presets.count == 0) {
+                
+                [self fetchPresetsForVideo:entry withPriority:CNMRequestPrefetchPriority completion:nil];
+            }
+        }
+    });
+}
+
+- (void)fetchAndUpdateDataForVideo:(CNMVideo *)video withCompletion:(void(^)(CNMVideo *video))block {
+    
+    [self fetchPresetsForVideo:video withPriority:CNMRequestInteractivePriority completion:block];
+}
+
+- (void)fetchPresetsForVideo:(CNMVideo *)video withPriority:(CNMRequestPriority)priority
+                  completion:(void(^)(CNMVideo *video))block {
+    
+    CNMVimeoVideoRequest *request = [CNMVimeoVideoRequest requestForVideo:video];
+    request.priority = priority;
+    
+    // Response delivered right to the state queue where entry will be replaced with updated copy.
+    __weak __typeof__(self) weakSelf = self;
+    [self.networkManager fetchJSONWithRequest:request elementDecoder:nil callbackQueue:self.stateQueue
+                              completionBlock:^(id JSONObject, NSError *error) {
+        
+        CNMVideo *updatedVideo = (!error ? [weakSelf handleVideoResponse:JSONObject forEntry:video] : nil);
+        if (block) { dispatch_async(dispatch_get_main_queue(), ^{ block(updatedVideo ?: video); }); }
     }];
 }
 
@@ -250,103 +823,334 @@ static NSInteger const kCNMMaximumEntriesPerRequest = 5;
     
     if (((NSArray *)data[@"data"]).count) {
         
-        NSArray *videoEntries = [(NSArray *)data[@"data"] cnm_shuffledArray];
+#if DEBUG
+        CFAbsoluteTime processingDate = CFAbsoluteTimeGetCurrent();
+#endif
+        NSArray<CNMVideo *> *videoEntries = [(NSArray *)data[@"data"] cnm_shuffledArray];
         self.totalEntriesCount = ((NSNumber *)data[@"total"]).unsignedIntegerValue;
-        self.hasMorePages = (data[@"paging"][@"next"] != nil); 
+        [self updatePaginationWithResponse:data];
         NSUInteger currentIndex = self.totalEntriesCount;
         if (self.entries.count > 0 && !self.fetchingFreshPage) {
             
-            currentIndex = [self sortedEntries].lastObject.idx.unsignedIntegerValue - 1;
+            currentIndex = self.entries.lastEntry.idx.unsignedIntegerValue - 1;
         }
         
         NSMutableArray *videos = [NSMutableArray new];
-        for (NSDictionary *videoInformation in videoEntries) {
+        NSUInteger overlappingEntriesCount = 0;
+        for (CNMVideo *decodedVideo in videoEntries) {
             
-            CNMVideo *video = [CNMVideo new];
-            [video mapDataFromDictionary:videoInformation];
+            // New uploads shift pages on remote data provider, so next page may start with already stored
+            // entries. They dropped before any index or credits work is spent on them.
+            if (!self.fetchingFreshPage && [self.entries entryWithIdentifier:decodedVideo.identifier]) {
+                
+                overlappingEntriesCount++;
+                continue;
+            }
+            
+            // Decoded entries can be shared with response cache, so they shouldn't be modified.
+            CNMVideo *video = [decodedVideo copy];
             video.idx = @(currentIndex);
             currentIndex--;
             [videos addObject:video];
         }
+#if DEBUG
+        if (overlappingEntriesCount) {
+            
+            NSLog(@"<Continuum::Paging> Dropped %lu overlapping entries", (unsigned long)overlappingEntriesCount);
+        }
+#endif
         [self handleParseCompletion:videos withCompletion:block];
+#if DEBUG
+        NSLog(@"<Continuum::Paging> Page of %lu entries merged on state queue in %.2f ms",
+              (unsigned long)videos.count, (CFAbsoluteTimeGetCurrent() - processingDate) * 1000.0f);
+#endif
+    }
+    else { block(self.entries.snapshot, error); }
+}
+
+- (void)handleDeltaResponse:(NSDictionary *)data withError:(NSError *)error atOffset:(NSUInteger)offset
+                   pageSize:(NSUInteger)pageSize addedEntries:(NSMutableArray<CNMVideo *> *)addedEntries
+                 completion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block {
+    
+    NSArray<CNMVideo *> *videoEntries = data[@"data"];
+    if (error || !videoEntries) {
+        
+        block(self.entries.snapshot, error);
+        return;
+    }
+    
+    // Channel entries ordered by date when they has been added, so all entries before first known entry is new.
+    // Uploads which happen while pages walked shift them, so same entry may arrive twice.
+    NSSet<NSString *> *addedIdentifiers = [NSSet setWithArray:[addedEntries valueForKey:@"identifier"]];
+    BOOL knownEntryFound = NO;
+    for (CNMVideo *decodedVideo in videoEntries) {
+        
+        if ([self.entries entryWithIdentifier:decodedVideo.identifier]) {
+            
+            knownEntryFound = YES;
+            break;
+        }
+        if (![addedIdentifiers containsObject:decodedVideo.identifier]) { [addedEntries addObject:decodedVideo]; }
+    }
+    
+    if (!knownEntryFound) {
+        
+        // Feed has been changed too much (or all known entries has been removed from it), so it fetched from
+        // the beginning.
+        NSUInteger nextOffset = offset + pageSize;
+        if (videoEntries.count < pageSize || nextOffset >= kCNMMaximumDeltaSyncEntries) {
+            
+            [self fetchFreshPageWithCompletion:block];
+        }
+        else {
+            
+            [self fetchEntriesAddedAtOffset:nextOffset pageSize:nextOffset addedEntries:addedEntries
+                                 completion:block];
+        }
+        return;
+    }
+    
+    // Feed doesn't have new entries, so there is nothing to merge or store.
+    if (addedEntries.count == 0) {
+        
+        block(self.entries.snapshot, nil);
+        return;
+    }
+    
+#if DEBUG
+    CFAbsoluteTime processingDate = CFAbsoluteTimeGetCurrent();
+#endif
+    // Stored entries keep their \c idx, so new entries numbered above newest stored entry.
+    self.totalEntriesCount = ((NSNumber *)data[@"total"]).unsignedIntegerValue;
+    NSUInteger currentIndex = self.entries.firstEntry.idx.unsignedIntegerValue + addedEntries.count;
+    NSMutableArray *videos = [NSMutableArray new];
+    for (CNMVideo *decodedVideo in [addedEntries cnm_shuffledArray]) {
+        
+        // Decoded entries can be shared with response cache, so they shouldn't be modified.
+        CNMVideo *video = [decodedVideo copy];
+        video.idx = @(currentIndex);
+        currentIndex--;
+        [videos addObject:video];
+    }
+    
+    [self shiftPaginationByEntriesCount:videos.count];
+    [self handleParseCompletion:videos withCompletion:block];
+#if DEBUG
+    NSLog(@"<Continuum::Paging> %lu new entries found within %lu newest entries and merged in %.2f ms",
+          (unsigned long)videos.count, (unsigned long)(offset + pageSize),
+          (CFAbsoluteTimeGetCurrent() - processingDate) * 1000.0f);
+#endif
+}
+
+- (void)handlePageRequest:(CNMVimeoChannelVideosRequest *)request withSequence:(NSUInteger)sequence
+       completionWithData:(NSDictionary *)data error:(NSError *)error {
+    
+    // Request has been cancelled.
+    if (self.pageRequests[@(sequence)] != request) { return; }
+    
+    [self.pageRequests removeObjectForKey:@(sequence)];
+    self.receivedPages[@(sequence)] = (error ?: (data ?: [NSNull null]));
+    
+    __weak __typeof__(self) weakSelf = self;
+    void(^mergeBlock)(NSArray<CNMVideo *> *, NSError *) = ^(NSArray<CNMVideo *> *feed, NSError *mergeError) {
+        
+        [weakSelf completeNextPageFetchesWithError:mergeError];
+    };
+    
+    id page = nil;
+    while ((page = self.receivedPages[@(self.mergedPageSequence)])) {
+        
+        [self.receivedPages removeObjectForKey:@(self.mergedPageSequence)];
+        self.mergedPageSequence++;
+        if ([page isKindOfClass:NSDictionary.class]) {
+            
+            [self handleFeedResponse:page withError:nil completion:mergeBlock];
+        }
+        else {
+            
+            // Pages which follow failed page can't be merged w/o it, so they will be requested again.
+            [self resetNextPageRequests];
+            [self completeNextPageFetchesWithError:([page isKindOfClass:NSError.class] ? page : nil)];
+        }
+    }
+}
+
+- (void)completeNextPageFetchesWithError:(NSError *)error {
+    
+    NSArray<void(^)(NSArray<CNMVideo *> *, NSError *)> *blocks = [self.pageCompletionBlocks copy];
+    [self.pageCompletionBlocks removeAllObjects];
+    self.hasUndeliveredPages = (blocks.count == 0);
+    NSArray<CNMVideo *> *feed = self.entries.snapshot;
+    for (void(^block)(NSArray<CNMVideo *> *, NSError *) in blocks) {
+        
+        [self deliverFeed:feed withError:error toBlock:block];
     }
-    else { dispatch_async(dispatch_get_main_queue(), ^{ block([self sortedEntries], error); }); }
 }
 
 - (void)handleParseCompletion:(NSArray<CNMVideo *> *)videos 
                withCompletion:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block {
 
-    dispatch_group_t processingGroup = dispatch_group_create();
-    
     // Store fetched objects.
+    NSMutableArray<CNMVideo *> *videosWithoutAuthor = [NSMutableArray new];
     for (CNMVideo *video in videos) { 
         
-        if (!self.entries[video.identifier]) {
+        CNMVideo *storedVideo = [self.entries entryWithIdentifier:video.identifier];
+        if (storedVideo) {
             
-            if (self.entries[video.identifier].author.length == 0) {
-                
-                dispatch_group_enter(processingGroup);
-                CNMVimeoVideoCreditsRequest *request = [CNMVimeoVideoCreditsRequest requestForVideo:video];
-                
-                __weak __typeof__(self) weakSelf = self;
-                [self.networkManager fetchJSONWithRequest:request
-                                          completionBlock:^(id JSONObject, NSError *error) {
-                    
-                    __typeof__(weakSelf) strongSelf = weakSelf;
-                    [video updateCredits:((NSDictionary *)JSONObject)[@"data"]];
-                    strongSelf.entries[video.identifier] = video;
-                    dispatch_group_leave(processingGroup);
-                }];
-            }
-            else { self.entries[video.identifier] = video; }
+            // Merge changes into copy of entry which has been restored from snapshot or fetched earlier, because
+            // it may be used by main queue (copy take it's position in feed).
+            video.idx = storedVideo.idx;
+            CNMVideo *mergedVideo = [storedVideo copy];
+            [mergedVideo updateWithVideo:video];
+            [self.entries replaceEntry:storedVideo withEntry:mergedVideo];
+        }
+        else if ([self.entries addEntry:video] && video.author.length == 0) {
+            
+            [videosWithoutAuthor addObject:video];
         }
     }
     
-    dispatch_group_notify(processingGroup, dispatch_get_main_queue(), ^{
+    // Author picked from credits which can't be fetched with channel page, so new entries wait for credits and
+    // page delivered w/o waiting for them.
+    [self.creditsLoader loadCreditsForVideos:videosWithoutAuthor];
+    [self storeSnapshot];
+    block(self.entries.snapshot, nil);
+}
+
+- (void)handleCredits:(NSArray<NSDictionary<NSString *, id> *> *)credits forEntry:(CNMVideo *)video {
+    
+    // Entry could be replaced with merged copy while credits has been fetched.
+    CNMVideo *storedVideo = [self.entries entryWithIdentifier:video.identifier];
+    if (!storedVideo) { return; }
+    
+    // Stubs can be used by main queue too, so stub copy updated (author preserved when stub will be restored).
+    CNMVideo *updatedVideo = [storedVideo copy];
+    [updatedVideo updateCredits:credits];
+    if (updatedVideo.author.length) {
         
-        block([self sortedEntries], nil);
-    });
+        [self.entries replaceEntry:storedVideo withEntry:updatedVideo];
+        [self storeSnapshot];
+        void(^handler)(CNMVideo *) = self.entryUpdateHandler;
+        if (handler && !updatedVideo.isStub) {
+            
+            dispatch_async(dispatch_get_main_queue(), ^{ handler(updatedVideo); });
+        }
+    }
 }
 
-- (void)handleVideoResponse:(NSDictionary *)data withError:(NSError *)error 
-                 completion:(void(^)(CNMVideo *video))block {
+- (CNMVideo *)handleVideoResponse:(NSDictionary *)data forEntry:(CNMVideo *)video {
+    
+    if (!data[@"link"]) { return nil; }
+    
+    CNMVideo *fetchedVideo = [CNMVideo new];
+    [fetchedVideo mapDataFromDictionary:data];
+    
+    // Entry could be replaced with merged copy while data has been fetched or removed with feed.
+    CNMVideo *storedVideo = [self.entries entryWithIdentifier:video.identifier];
     
-    CNMVideo *video = nil;
-    if (data[@"link"]) {
+    // Entry will be played, so stub restored along with update.
+    CNMVideo *updatedVideo = [[self.window restoredEntry:(storedVideo ?: video)] copy];
+    [updatedVideo updateWithVideo:fetchedVideo];
+    if (storedVideo) {
         
-        video = [CNMVideo new];
-        [video mapDataFromDictionary:data];
+        [self.entries replaceEntry:storedVideo withEntry:updatedVideo];
+        [self storeSnapshot];
+        void(^handler)(CNMVideo *) = self.entryUpdateHandler;
+        if (handler && !updatedVideo.isStub) {
+            
+            dispatch_async(dispatch_get_main_queue(), ^{ handler(updatedVideo); });
+        }
     }
-    dispatch_async(dispatch_get_main_queue(), ^{ block(video); });
+    
+    return updatedVideo;
 }
 
 
 #pragma mark - Misc
 
-- (NSArray<CNMVideo *> *)sortedEntries {
+- (void)dealloc {
+    
+    // Loader state accessed only from state queue.
+    CNMVideoCreditsLoader *creditsLoader = self.creditsLoader;
+    dispatch_async(self.stateQueue, ^{ [creditsLoader cancel]; });
+    [self.networkManager cancelAllRequests];
+}
+
+- (void)deliverFeed:(NSArray<CNMVideo *> *)feed withError:(NSError *)error
+            toBlock:(void(^)(NSArray<CNMVideo *> *feed, NSError *error))block {
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+
+#if DEBUG
+        CFAbsoluteTime deliveryDate = CFAbsoluteTimeGetCurrent();
+#endif
+        block(feed, error);
+#if DEBUG
+        NSLog(@"<Continuum::Paging> Feed of %lu entries used main queue for %.2f ms", (unsigned long)feed.count,
+              (CFAbsoluteTimeGetCurrent() - deliveryDate) * 1000.0f);
+#endif
+    });
+}
+
+- (void)storeSnapshot {
     
-    static NSSortDescriptor *_sortDescriptor;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
+    if (self.isSnapshotStoreScheduled) { return; }
+    
+    // Manager kept alive till scheduled write, so last feed state won't be lost.
+    self.snapshotStoreScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kCNMSnapshotStoreDelay * NSEC_PER_SEC)),
+                   self.stateQueue, ^{
         
-        _sortDescriptor = [[NSSortDescriptor alloc] initWithKey:@"idx" ascending:NO];
+        self.snapshotStoreScheduled = NO;
+        [self flushSnapshot];
     });
+}
+
+- (void)flushSnapshot {
+    
+    // Compacted entries stored with records which has been written for them by window.
+    NSArray<CNMVideo *> *entries = self.entries.snapshot;
+    NSMutableArray<NSData *> *records = [NSMutableArray arrayWithCapacity:entries.count];
+    for (CNMVideo *video in entries) { [records addObject:[self.window recordForEntry:video]]; }
+    [self.snapshot storeEntryRecords:records totalEntriesCount:self.totalEntriesCount];
+}
+
+- (void)updatePaginationWithResponse:(NSDictionary *)data {
     
-    return [self.entries.allValues sortedArrayUsingDescriptors:@[_sortDescriptor]];
+    NSUInteger page = ((NSNumber *)data[@"page"]).unsignedIntegerValue;
+    NSUInteger pageSize = ((NSNumber *)data[@"per_page"]).unsignedIntegerValue;
+    NSUInteger nextPageOffset = page * pageSize;
+    if (nextPageOffset >= self.nextPageOffset) {
+        
+        id cursor = data[@"paging"][@"next"];
+        self.nextPageCursor = ([cursor isKindOfClass:NSString.class] ? cursor : nil);
+        self.nextPageOffset = nextPageOffset;
+        self.hasMorePages = (self.nextPageCursor != nil);
+    }
 }
 
-- (NSUInteger)nextPageIndex {
+- (void)shiftPaginationByEntriesCount:(NSUInteger)count {
     
-    NSUInteger nextPageIndex = 1;
-    if (self.entries.count) {
+    NSURLComponents *components = (self.nextPageCursor ? [NSURLComponents componentsWithString:self.nextPageCursor]
+                                                        : nil);
+    NSUInteger pageSize = 0;
+    NSMutableArray<NSURLQueryItem *> *queryItems = [NSMutableArray new];
+    for (NSURLQueryItem *item in components.queryItems) {
         
-        double lastCachedIdx = (double)(self.sortedEntries.lastObject.idx.unsignedIntegerValue - 1);
-        double indexOffset = (double)self.totalEntriesCount - lastCachedIdx;
-        double lastCachedPage = indexOffset / kCNMMaximumEntriesPerRequest;
-        if (lastCachedIdx > 1.0f) { nextPageIndex = (NSUInteger)lastCachedPage + 1; }
+        if ([item.name isEqualToString:@"per_page"]) { pageSize = (NSUInteger)item.value.integerValue; }
+        if (![item.name isEqualToString:@"page"]) { [queryItems addObject:item]; }
     }
     
-    return nextPageIndex;
+    if (pageSize == 0) { self.nextPageOffset += count; }
+    else {
+        
+        NSUInteger page = (self.nextPageOffset + count) / pageSize + 1;
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"page" value:@(page).stringValue]];
+        components.queryItems = queryItems;
+        self.nextPageCursor = components.string;
+        self.nextPageOffset = (page - 1) * pageSize;
+    }
+    self.requestedPageOffset = self.nextPageOffset;
 }
 
 #pragma mark - 
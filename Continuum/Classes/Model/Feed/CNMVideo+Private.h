@@ -8,7 +8,72 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-#pragma mark Private interface declaration
+#pragma mark Structures
+
+/**
+ @brief  Structure describes video representation structure.
+ */
+struct CNMVideoDataStructure {
+    
+    /**
+     @brief  Stores key under which stored data from which video identifier can be extracted.
+     */
+    __unsafe_unretained NSString *identifier;
+    
+    /**
+     @brief  Stores key-path under which stored list of available images associated with video.
+     */
+    struct {
+        
+        /**
+         @brief  Stores key under which stored key-path from viedeo data which store pictures set.
+         */
+        __unsafe_unretained NSString *key;
+        
+        /**
+         @brief  Stores key under which stored video snapshot image width.
+         */
+        __unsafe_unretained NSString *width;
+        
+        /**
+         @brief  Stores key under which stored video snapshot image height.
+         */
+        __unsafe_unretained NSString *height;
+        
+        /**
+         @brief  Stores key under which stored video snapshot image url.
+         */
+        __unsafe_unretained NSString *url;
+    } images;
+    
+    /**
+     @brief  Stores key under which video name is stored.
+     */
+    __unsafe_unretained NSString *name;
+    
+    /**
+     @brief  Stores key under which video file duration is stored.
+     */
+    __unsafe_unretained NSString *duration;
+    
+    /**
+     @brief  Stores key under which video file upload date is stored.
+     */
+    __unsafe_unretained NSString *creationDate;
+    
+    /**
+     @brief  Stores key under which video presets is stored.
+     */
+    __unsafe_unretained NSString *presets;
+};
+
+/**
+ @brief  Stores keys under which data stored in remote data provider response.
+ */
+extern struct CNMVideoDataStructure CNMVideoData;
+
+
+#pragma mark - Private interface declaration
 
 @interface CNMVideo ()
 
@@ -23,6 +88,22 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) NSDate *creationDate;
 @property (nonatomic, nullable, strong) NSArray<CNMVideoPreset *> *presets;
 
+/**
+ @brief  Stores whether entry has been compacted to stub which keep only identifier, idx and location of entry
+         record on disk.
+ */
+@property (nonatomic, assign, getter = isStub) BOOL stub;
+
+/**
+ @brief  Stores offset of entry record in file where records of compacted entries is stored.
+ */
+@property (nonatomic, assign) unsigned long long recordOffset;
+
+/**
+ @brief  Stores length of entry record in file where records of compacted entries is stored.
+ */
+@property (nonatomic, assign) NSUInteger recordLength;
+
 
 #pragma mark - Data mapping
 
@@ -33,6 +114,39 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)mapDataFromDictionary:(NSDictionary *)information;
 
+
+#pragma mark - Compaction
+
+/**
+ @brief  Release all entry information except identifier and idx.
+ 
+ @param offset Offset of entry record in file where records of compacted entries is stored.
+ @param length Length of entry record.
+ */
+- (void)compactWithRecordOffset:(unsigned long long)offset length:(NSUInteger)length;
+
+/**
+ @brief      Restore entry information from entry which has been decoded from stored record.
+ @discussion Information which has been received by stub after compaction (like author from credits) is
+             preserved.
+ 
+ @param video Reference on entry which has been decoded from stored record.
+ */
+- (void)restoreFromVideo:(CNMVideo *)video;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Extract video ientifier from passed \c data object.
+ 
+ @param data Reference on data from which identifier should be
+             extracted.
+ 
+ @return Video identifier on remote data provider.
+ */
++ (NSString *)identifierFromData:(NSString *)data;
+
 #pragma mark -
 
 
@@ -15,7 +15,7 @@ NS_ASSUME_NONNULL_BEGIN
  @since 1.0
  @copyright © 2015 Continuum LLC.
  */
-@interface CNMVideo : NSObject
+@interface CNMVideo : NSObject <NSCopying>
 
 
 ///------------------------------------------------
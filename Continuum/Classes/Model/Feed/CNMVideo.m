@@ -10,62 +10,7 @@
 
 #pragma mark Structures
 
-/**
- @brief  Structure describes video representation structure.
- */
-struct CNMVideoDataStructure {
-
-    /**
-     @brief  Stores key under which stored data from which video identifier can be extracted.
-     */
-    __unsafe_unretained NSString *identifier;
-
-    /**
-     @brief  Stores key-path under which stored list of available images associated with video.
-     */
-    struct {
-        
-        /**
-         @brief  Stores key under which stored key-path from viedeo data which store pictures set.
-         */
-        __unsafe_unretained NSString *key;
-        
-        /**
-         @brief  Stores key under which stored video snapshot image width.
-         */
-        __unsafe_unretained NSString *width;
-        
-        /**
-         @brief  Stores key under which stored video snapshot image height.
-         */
-        __unsafe_unretained NSString *height;
-        
-        /**
-         @brief  Stores key under which stored video snapshot image url.
-         */
-        __unsafe_unretained NSString *url;
-    } images;
-    
-    /**
-     @brief  Stores key under which video name is stored.
-     */
-    __unsafe_unretained NSString *name;
-    
-    /**
-     @brief  Stores key under which video file duration is stored.
-     */
-    __unsafe_unretained NSString *duration;
-    
-    /**
-     @brief  Stores key under which video file upload date is stored.
-     */
-    __unsafe_unretained NSString *creationDate;
-    
-    /**
-     @brief  Stores key under which video presets is stored.
-     */
-    __unsafe_unretained NSString *presets;
-} CNMVideoData = {
+struct CNMVideoDataStructure CNMVideoData = {
     
     .identifier = @"link",
     .images = {
@@ -88,16 +33,6 @@ struct CNMVideoDataStructure {
 
 #pragma mark - Misc
 
-/**
- @brief  Extract video ientifier from passed \c data object.
- 
- @param data Reference on data from which identifier should be
-             extracted.
- 
- @return Video identifier on remote data provider.
- */
-+ (NSString *)identifierFromData:(NSString *)data;
-
 /**
  @brief  Retrieve URL on video image which will best fit to device
          screen size.
@@ -114,7 +49,8 @@ struct CNMVideoDataStructure {
  
  @param presets List of video file presets.
  
- @return List of configured and ready to use video preset instances.
+ @return List of configured and ready to use video preset instances or \c nil in case if \c data doesn't
+         have presets.
  */
 - (NSArray<CNMVideoPreset *> *)videoPresetsFromData:(NSDictionary *)data;
 
@@ -170,6 +106,45 @@ struct CNMVideoDataStructure {
 }
 
 
+#pragma mark - Compaction
+
+- (void)compactWithRecordOffset:(unsigned long long)offset length:(NSUInteger)length {
+    
+    _imagePath = nil;
+    _name = nil;
+    _author = nil;
+    _creationDate = nil;
+    _presets = nil;
+    self.recordOffset = offset;
+    self.recordLength = length;
+    self.stub = YES;
+}
+
+- (void)restoreFromVideo:(CNMVideo *)video {
+    
+    CNMVideo *stub = [self copy];
+    [self updateWithVideo:video];
+    [self updateWithVideo:stub];
+    self.stub = NO;
+}
+
+
+#pragma mark - Copying
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    CNMVideo *video = [[self.class allocWithZone:zone] init];
+    [video updateWithVideo:self];
+    
+    // Copy of compacted entry should be restorable from same record.
+    video.stub = self.isStub;
+    video.recordOffset = self.recordOffset;
+    video.recordLength = self.recordLength;
+    
+    return video;
+}
+
+
 #pragma mark - Data mapping
 
 - (void)mapDataFromDictionary:(NSDictionary *)information {
@@ -217,9 +192,11 @@ struct CNMVideoDataStructure {
 
 - (NSArray<CNMVideoPreset *> *)videoPresetsFromData:(NSDictionary *)data {
     
+    NSArray<NSDictionary *> *presets = data[CNMVideoData.presets];
+    if (![presets isKindOfClass:NSArray.class]) { return nil; }
+    
     NSMutableSet *presetSet = [NSMutableSet new];
     NSNumber *duration = data[CNMVideoData.duration];
-    NSArray<NSDictionary *> *presets = data[CNMVideoData.presets];
     [presets enumerateObjectsUsingBlock:^(NSDictionary *presetInformation, NSUInteger presetInformationIdx, 
                                           BOOL *presetsInformationEnumeratorStop) {
         
@@ -0,0 +1,77 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMNetorkManager, CNMVideo;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Loader which fetch credits for video entries which doesn't have author information.
+ @discussion Channel page doesn't provide credits, so author of each new entry picked from credits fetched by
+             loader. Loader limit how many credits requests can be active at once, so they won't take all
+             connections from feed pages. Videos which wait for credits doesn't block feed delivery: fetched
+             credits passed to \c updateHandler and loader never modify video entries by itself.
+             Instance should be used from queue which has been passed during loader configuration.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoCreditsLoader : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on block which is called on loader's queue each time when credits for video entry has
+         been fetched.
+ */
+@property (nonatomic, nullable, copy) void(^updateHandler)(CNMVideo *video,
+                                                           NSArray<NSDictionary<NSString *, id> *> *credits);
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure credits loader.
+ 
+ @param manager Reference on network manager which should be used to fetch credits.
+ @param count   Maximum number of credits requests which can be active at once.
+ @param queue   Reference on serial queue on which loader is used and \c updateHandler is called.
+ 
+ @return Configured and ready to use loader.
+ */
++ (instancetype)loaderWithNetworkManager:(CNMNetorkManager *)manager maximumConcurrentRequests:(NSUInteger)count
+                                   queue:(dispatch_queue_t)queue;
+
+
+///------------------------------------------------
+/// @name Credits
+///------------------------------------------------
+
+/**
+ @brief      Schedule credits fetch for passed videos.
+ @discussion Videos which already has author or already scheduled will be ignored.
+ 
+ @param videos List of video entries for which credits should be fetched.
+ */
+- (void)loadCreditsForVideos:(NSArray<CNMVideo *> *)videos;
+
+/**
+ @brief  Cancel all active credits requests and drop scheduled ones.
+ */
+- (void)cancel;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
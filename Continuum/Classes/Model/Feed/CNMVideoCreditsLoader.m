@@ -0,0 +1,181 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoCreditsLoader.h"
+#import "CNMVimeoVideoCreditsRequest.h"
+#import "CNMNetorkManager.h"
+#import "CNMVideo.h"
+
+
+#pragma mark Private interface declaration
+
+@interface CNMVideoCreditsLoader ()
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on network manager which is used to fetch credits.
+ */
+@property (nonatomic) CNMNetorkManager *networkManager;
+
+/**
+ @brief  Stores maximum number of credits requests which can be active at once.
+ */
+@property (nonatomic, assign) NSUInteger maximumConcurrentRequests;
+
+/**
+ @brief  Stores reference on queue on which loader state is accessed.
+ */
+@property (nonatomic) dispatch_queue_t queue;
+
+/**
+ @brief  Stores reference on dictionary where each key is video identifier and value is video entry which wait
+         for credits or for which credits is fetching at this moment.
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, CNMVideo *> *videos;
+
+/**
+ @brief  Stores reference on identifiers of videos which wait for credits request start (in schedule order).
+ */
+@property (nonatomic) NSMutableOrderedSet<NSString *> *pendingIdentifiers;
+
+/**
+ @brief  Stores reference on dictionary where each key is video identifier and value is active credits request.
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, CNMVimeoVideoCreditsRequest *> *activeRequests;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize credits loader.
+ 
+ @param manager Reference on network manager which should be used to fetch credits.
+ @param count   Maximum number of credits requests which can be active at once.
+ @param queue   Reference on serial queue on which loader is used and \c updateHandler is called.
+ 
+ @return Initialized and ready to use loader.
+ */
+- (instancetype)initWithNetworkManager:(CNMNetorkManager *)manager maximumConcurrentRequests:(NSUInteger)count
+                                 queue:(dispatch_queue_t)queue;
+
+
+#pragma mark - Credits
+
+/**
+ @brief  Start credits requests for scheduled videos while there is free slots.
+ */
+- (void)startPendingRequests;
+
+/**
+ @brief  Handle credits request completion.
+ 
+ @param request Reference on request which has been completed.
+ @param data    Reference on remote data provider response.
+ @param video   Reference on video entry for which credits has been requested.
+ */
+- (void)handleCreditsRequest:(CNMVimeoVideoCreditsRequest *)request completionWithData:(NSDictionary *)data
+                    forVideo:(CNMVideo *)video;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoCreditsLoader
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)loaderWithNetworkManager:(CNMNetorkManager *)manager maximumConcurrentRequests:(NSUInteger)count
+                                   queue:(dispatch_queue_t)queue {
+    
+    return [[self alloc] initWithNetworkManager:manager maximumConcurrentRequests:count queue:queue];
+}
+
+- (instancetype)initWithNetworkManager:(CNMNetorkManager *)manager maximumConcurrentRequests:(NSUInteger)count
+                                 queue:(dispatch_queue_t)queue {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _networkManager = manager;
+        _maximumConcurrentRequests = MAX(count, 1);
+        _queue = queue;
+        _videos = [NSMutableDictionary new];
+        _pendingIdentifiers = [NSMutableOrderedSet new];
+        _activeRequests = [NSMutableDictionary new];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Credits
+
+- (void)loadCreditsForVideos:(NSArray<CNMVideo *> *)videos {
+    
+    for (CNMVideo *video in videos) {
+        
+        if (video.author.length == 0 && video.identifier && !self.videos[video.identifier]) {
+            
+            self.videos[video.identifier] = video;
+            [self.pendingIdentifiers addObject:video.identifier];
+        }
+    }
+    [self startPendingRequests];
+}
+
+- (void)cancel {
+    
+    NSArray<CNMVimeoVideoCreditsRequest *> *requests = self.activeRequests.allValues;
+    [self.activeRequests removeAllObjects];
+    [self.pendingIdentifiers removeAllObjects];
+    [self.videos removeAllObjects];
+    for (CNMVimeoVideoCreditsRequest *request in requests) { [self.networkManager cancelRequest:request]; }
+}
+
+- (void)startPendingRequests {
+    
+    while (self.activeRequests.count < self.maximumConcurrentRequests && self.pendingIdentifiers.count) {
+        
+        NSString *identifier = self.pendingIdentifiers.firstObject;
+        [self.pendingIdentifiers removeObjectAtIndex:0];
+        CNMVideo *video = self.videos[identifier];
+        CNMVimeoVideoCreditsRequest *request = [CNMVimeoVideoCreditsRequest requestForVideo:video];
+        self.activeRequests[identifier] = request;
+        
+        __weak __typeof__(self) weakSelf = self;
+        [self.networkManager fetchJSONWithRequest:request elementDecoder:nil callbackQueue:self.queue
+                                  completionBlock:^(id JSONObject, NSError *error) {
+            
+            [weakSelf handleCreditsRequest:request completionWithData:JSONObject forVideo:video];
+        }];
+    }
+}
+
+- (void)handleCreditsRequest:(CNMVimeoVideoCreditsRequest *)request completionWithData:(NSDictionary *)data
+                    forVideo:(CNMVideo *)video {
+    
+    // Request has been cancelled.
+    if (self.activeRequests[video.identifier] != request) { return; }
+    
+    [self.activeRequests removeObjectForKey:video.identifier];
+    [self.videos removeObjectForKey:video.identifier];
+    [self startPendingRequests];
+    if ([data isKindOfClass:NSDictionary.class] && [data[@"data"] isKindOfClass:NSArray.class]) {
+        
+        if (self.updateHandler) { self.updateHandler(video, data[@"data"]); }
+    }
+}
+
+#pragma mark -
+
+
+@end
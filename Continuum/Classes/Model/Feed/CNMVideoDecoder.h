@@ -0,0 +1,66 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMVideo;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Decoder which fill video data models directly from remote data provider response bytes.
+ @discussion Decoder use keys from \c CNMVideoData and \c CNMVideoPresetData structures to build field dispatch
+             tables, so there is no intermediate \b NSDictionary tree and values for fields which is not used
+             by data models skipped w/o allocation. Repeated strings (like preset quality names) interned, so
+             all presets share same instances.
+             Instance is not thread-safe and all calls should be done from same serial queue.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoDecoder : NSObject
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure video decoder.
+ 
+ @return Configured and ready to use decoder.
+ */
++ (instancetype)decoder;
+
+
+///------------------------------------------------
+/// @name Decoding
+///------------------------------------------------
+
+/**
+ @brief  Decode single video entry from it's binary representation.
+ 
+ @param data Reference on binary representation of video entry object.
+ 
+ @return Decoded video entry or \c nil in case if \c data doesn't represent video.
+ */
+- (nullable CNMVideo *)videoFromData:(NSData *)data;
+
+/**
+ @brief  Decode list of video entries from whole response body.
+ 
+ @param key  Name of root object member which store list of video entries.
+ @param data Reference on response body.
+ 
+ @return List of decoded video entries or \c nil in case if \c data has unexpected layout.
+ */
+- (nullable NSArray<CNMVideo *> *)videosFromCollection:(NSString *)key inData:(NSData *)data;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
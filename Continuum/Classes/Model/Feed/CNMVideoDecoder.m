@@ -0,0 +1,835 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoDecoder.h"
+#import "CNMVideoPreset+Private.h"
+#import "CNMVideo+Private.h"
+#import <UIKit/UIKit.h>
+
+
+#pragma mark Types
+
+/**
+ @brief  Data model fields which can be filled by decoder.
+ */
+typedef NS_ENUM(NSUInteger, CNMVideoDecoderField) {
+    
+    /**
+     @brief  Value is not used by data models and should be skipped.
+     */
+    CNMVideoDecoderUnknownField,
+    CNMVideoDecoderIdentifierField,
+    CNMVideoDecoderImagesField,
+    CNMVideoDecoderNameField,
+    CNMVideoDecoderDurationField,
+    CNMVideoDecoderCreationDateField,
+    CNMVideoDecoderPresetsField,
+    CNMVideoDecoderImageHeightField,
+    CNMVideoDecoderImageURLField,
+    CNMVideoDecoderPresetWidthField,
+    CNMVideoDecoderPresetHeightField,
+    CNMVideoDecoderPresetSizeField,
+    CNMVideoDecoderPresetURLField,
+    CNMVideoDecoderPresetQualityField
+};
+
+
+#pragma mark - Structures
+
+/**
+ @brief  Structure describes field dispatch table entry.
+ */
+typedef struct CNMVideoDecoderFieldEntry {
+    
+    /**
+     @brief  Stores UTF-8 representation of key under which field value is stored.
+     */
+    const char *key;
+    
+    /**
+     @brief  Stores length of \c key in bytes.
+     */
+    size_t length;
+    
+    /**
+     @brief  Stores data model field which should be filled with value.
+     */
+    CNMVideoDecoderField field;
+} CNMVideoDecoderFieldEntry;
+
+/**
+ @brief  Structure describes position inside of response body.
+ */
+typedef struct CNMVideoDecoderCursor {
+    
+    /**
+     @brief  Stores pointer on response body bytes.
+     */
+    const uint8_t *bytes;
+    
+    /**
+     @brief  Stores response body length.
+     */
+    NSUInteger length;
+    
+    /**
+     @brief  Stores offset of byte which should be processed next.
+     */
+    NSUInteger offset;
+    
+    /**
+     @brief  Stores whether response body has malformed layout.
+     */
+    BOOL failed;
+} CNMVideoDecoderCursor;
+
+
+#pragma mark - Static
+
+/**
+ @brief  Field dispatch tables for video, image and video preset objects.
+ */
+static CNMVideoDecoderFieldEntry CNMVideoDecoderVideoFields[6];
+static CNMVideoDecoderFieldEntry CNMVideoDecoderImageFields[2];
+static CNMVideoDecoderFieldEntry CNMVideoDecoderPresetFields[5];
+
+/**
+ @brief  Stores components of key-path to the list of images which follow first component (it is dispatched
+         from \c CNMVideoDecoderVideoFields).
+ */
+static CNMVideoDecoderFieldEntry *CNMVideoDecoderImagesPath;
+static NSUInteger CNMVideoDecoderImagesPathLength;
+
+
+#pragma mark - Dispatch tables
+
+/**
+ @brief  Create field dispatch table entry.
+ 
+ @param key   Reference on key under which field value is stored.
+ @param field Data model field which should be filled with value.
+ 
+ @return Dispatch table entry which owns copy of \c key bytes.
+ */
+static CNMVideoDecoderFieldEntry CNMVideoDecoderFieldEntryMake(NSString *key, CNMVideoDecoderField field) {
+    
+    const char *bytes = strdup(key.UTF8String);
+    
+    return (CNMVideoDecoderFieldEntry){.key = bytes, .length = strlen(bytes), .field = field};
+}
+
+/**
+ @brief  Create components list for nested part of key-path.
+ 
+ @param components List of key-path components.
+ @param field      Data model field which should be filled with value stored at key-path.
+ @param length     Reference on pointer where number of nested components should be stored.
+ 
+ @return Entries for all \c components except first one.
+ */
+static CNMVideoDecoderFieldEntry *CNMVideoDecoderNestedPathMake(NSArray<NSString *> *components,
+                                                                CNMVideoDecoderField field, NSUInteger *length) {
+    
+    *length = components.count - 1;
+    CNMVideoDecoderFieldEntry *path = calloc(MAX(*length, 1), sizeof(CNMVideoDecoderFieldEntry));
+    for (NSUInteger componentIdx = 1; componentIdx < components.count; componentIdx++) {
+        
+        path[componentIdx - 1] = CNMVideoDecoderFieldEntryMake(components[componentIdx], field);
+    }
+    
+    return path;
+}
+
+/**
+ @brief  Build field dispatch tables from remote data provider response structure description.
+ */
+static void CNMVideoDecoderPrepareFields(void) {
+    
+    NSArray<NSString *> *imagesPath = [CNMVideoData.images.key componentsSeparatedByString:@"."];
+    CNMVideoDecoderVideoFields[0] = CNMVideoDecoderFieldEntryMake(CNMVideoData.identifier,
+                                                                  CNMVideoDecoderIdentifierField);
+    CNMVideoDecoderVideoFields[1] = CNMVideoDecoderFieldEntryMake(imagesPath.firstObject,
+                                                                  CNMVideoDecoderImagesField);
+    CNMVideoDecoderVideoFields[2] = CNMVideoDecoderFieldEntryMake(CNMVideoData.name, CNMVideoDecoderNameField);
+    CNMVideoDecoderVideoFields[3] = CNMVideoDecoderFieldEntryMake(CNMVideoData.duration,
+                                                                  CNMVideoDecoderDurationField);
+    CNMVideoDecoderVideoFields[4] = CNMVideoDecoderFieldEntryMake(CNMVideoData.creationDate,
+                                                                  CNMVideoDecoderCreationDateField);
+    CNMVideoDecoderVideoFields[5] = CNMVideoDecoderFieldEntryMake(CNMVideoData.presets,
+                                                                  CNMVideoDecoderPresetsField);
+    
+    CNMVideoDecoderImagesPath = CNMVideoDecoderNestedPathMake(imagesPath, CNMVideoDecoderImagesField,
+                                                              &CNMVideoDecoderImagesPathLength);
+    
+    CNMVideoDecoderImageFields[0] = CNMVideoDecoderFieldEntryMake(CNMVideoData.images.height,
+                                                                  CNMVideoDecoderImageHeightField);
+    CNMVideoDecoderImageFields[1] = CNMVideoDecoderFieldEntryMake(CNMVideoData.images.url,
+                                                                  CNMVideoDecoderImageURLField);
+    
+    CNMVideoDecoderPresetFields[0] = CNMVideoDecoderFieldEntryMake(CNMVideoPresetData.width,
+                                                                   CNMVideoDecoderPresetWidthField);
+    CNMVideoDecoderPresetFields[1] = CNMVideoDecoderFieldEntryMake(CNMVideoPresetData.height,
+                                                                   CNMVideoDecoderPresetHeightField);
+    CNMVideoDecoderPresetFields[2] = CNMVideoDecoderFieldEntryMake(CNMVideoPresetData.size,
+                                                                   CNMVideoDecoderPresetSizeField);
+    CNMVideoDecoderPresetFields[3] = CNMVideoDecoderFieldEntryMake(CNMVideoPresetData.url,
+                                                                   CNMVideoDecoderPresetURLField);
+    CNMVideoDecoderPresetFields[4] = CNMVideoDecoderFieldEntryMake(CNMVideoPresetData.quality,
+                                                                   CNMVideoDecoderPresetQualityField);
+}
+
+/**
+ @brief  Find data model field for key.
+ 
+ @param fields Reference on dispatch table which should be used.
+ @param count  Number of entries in \c fields.
+ @param key    Pointer on key bytes inside of response body.
+ @param length Length of \c key in bytes.
+ 
+ @return Data model field or \c CNMVideoDecoderUnknownField in case if value should be skipped.
+ */
+static inline CNMVideoDecoderField CNMVideoDecoderFieldForKey(const CNMVideoDecoderFieldEntry *fields,
+                                                              NSUInteger count, const uint8_t *key,
+                                                              NSUInteger length) {
+    
+    for (NSUInteger fieldIdx = 0; fieldIdx < count; fieldIdx++) {
+        
+        if (fields[fieldIdx].length == length && memcmp(fields[fieldIdx].key, key, length) == 0) {
+            
+            return fields[fieldIdx].field;
+        }
+    }
+    
+    return CNMVideoDecoderUnknownField;
+}
+
+
+#pragma mark - Scanning
+
+/**
+ @brief  Move cursor to the next significant character.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return Significant character or \c 0 in case if end of body has been reached.
+ */
+static inline uint8_t CNMVideoDecoderPeek(CNMVideoDecoderCursor *cursor) {
+    
+    while (cursor->offset < cursor->length) {
+        
+        uint8_t character = cursor->bytes[cursor->offset];
+        if (character != ' ' && character != '\n' && character != '\r' && character != '\t') { return character; }
+        cursor->offset++;
+    }
+    
+    return 0;
+}
+
+/**
+ @brief  Skip value which is not used by data models.
+ 
+ @param cursor Reference on cursor inside of response body.
+ */
+static void CNMVideoDecoderSkipValue(CNMVideoDecoderCursor *cursor) {
+    
+    CNMVideoDecoderPeek(cursor);
+    NSUInteger depth = 0;
+    BOOL inString = NO;
+    BOOL escaped = NO;
+    while (cursor->offset < cursor->length) {
+        
+        uint8_t character = cursor->bytes[cursor->offset];
+        if (inString) {
+            
+            if (escaped) { escaped = NO; }
+            else if (character == '\\') { escaped = YES; }
+            else if (character == '"') {
+                
+                inString = NO;
+                if (depth == 0) {
+                    
+                    cursor->offset++;
+                    return;
+                }
+            }
+        }
+        else if (character == '"') { inString = YES; }
+        else if (character == '{' || character == '[') { depth++; }
+        else if (character == '}' || character == ']') {
+            
+            // Closing bracket of enclosing container terminate scalar value.
+            if (depth == 0) { return; }
+            if (--depth == 0) {
+                
+                cursor->offset++;
+                return;
+            }
+        }
+        else if (depth == 0 && (character == ',' || character == ' ' || character == '\n' ||
+                                character == '\r' || character == '\t')) {
+            
+            return;
+        }
+        cursor->offset++;
+    }
+    cursor->failed = (cursor->failed || depth > 0 || inString);
+}
+
+/**
+ @brief  Enter container if it is next value.
+ 
+ @param cursor Reference on cursor inside of response body.
+ @param type   Opening character of expected container: \c { or \c [.
+ 
+ @return \c NO in case if next value is not container of expected type (value is skipped in this case).
+ */
+static BOOL CNMVideoDecoderEnterContainer(CNMVideoDecoderCursor *cursor, uint8_t type) {
+    
+    if (CNMVideoDecoderPeek(cursor) == type) {
+        
+        cursor->offset++;
+        return YES;
+    }
+    CNMVideoDecoderSkipValue(cursor);
+    
+    return NO;
+}
+
+/**
+ @brief  Locate bytes of string which is next value.
+ 
+ @param cursor     Reference on cursor inside of response body.
+ @param start      Reference on pointer where offset of first string character should be stored.
+ @param length     Reference on pointer where string length in bytes should be stored.
+ @param hasEscapes Reference on pointer where whether string has escaped characters or not should be stored.
+ 
+ @return \c NO in case if next value is not string (value is skipped in this case).
+ */
+static BOOL CNMVideoDecoderScanString(CNMVideoDecoderCursor *cursor, NSUInteger *start, NSUInteger *length,
+                                      BOOL *hasEscapes) {
+    
+    if (CNMVideoDecoderPeek(cursor) != '"') {
+        
+        CNMVideoDecoderSkipValue(cursor);
+        return NO;
+    }
+    
+    BOOL escaped = NO;
+    *hasEscapes = NO;
+    *start = ++cursor->offset;
+    for (; cursor->offset < cursor->length; cursor->offset++) {
+        
+        uint8_t character = cursor->bytes[cursor->offset];
+        if (escaped) { escaped = NO; }
+        else if (character == '\\') {
+            
+            escaped = YES;
+            *hasEscapes = YES;
+        }
+        else if (character == '"') {
+            
+            *length = cursor->offset - *start;
+            cursor->offset++;
+            return YES;
+        }
+    }
+    cursor->failed = YES;
+    
+    return NO;
+}
+
+/**
+ @brief  Move to the next member of object.
+ 
+ @param cursor Reference on cursor inside of response body.
+ @param first  Reference on flag which tell whether first member expected. Flag is reset by this function.
+ @param key    Reference on pointer where pointer on member name bytes should be stored.
+ @param length Reference on pointer where member name length should be stored.
+ 
+ @return \c NO in case if end of object has been reached or it is malformed.
+ */
+static BOOL CNMVideoDecoderNextMember(CNMVideoDecoderCursor *cursor, BOOL *first, const uint8_t **key,
+                                      NSUInteger *length) {
+    
+    uint8_t character = CNMVideoDecoderPeek(cursor);
+    if (character == '}') {
+        
+        cursor->offset++;
+        return NO;
+    }
+    if (!*first) {
+        
+        if (character != ',') {
+            
+            cursor->failed = YES;
+            return NO;
+        }
+        cursor->offset++;
+    }
+    
+    NSUInteger start = 0;
+    BOOL hasEscapes = NO;
+    // Keys used by data models doesn't have escaped characters, so they can be compared as raw bytes.
+    if (!CNMVideoDecoderScanString(cursor, &start, length, &hasEscapes) || CNMVideoDecoderPeek(cursor) != ':') {
+        
+        cursor->failed = YES;
+        return NO;
+    }
+    cursor->offset++;
+    *key = cursor->bytes + start;
+    *first = NO;
+    
+    return YES;
+}
+
+/**
+ @brief  Move to the next element of array.
+ 
+ @param cursor Reference on cursor inside of response body.
+ @param first  Reference on flag which tell whether first element expected. Flag is reset by this function.
+ 
+ @return \c NO in case if end of array has been reached or it is malformed.
+ */
+static BOOL CNMVideoDecoderNextElement(CNMVideoDecoderCursor *cursor, BOOL *first) {
+    
+    uint8_t character = CNMVideoDecoderPeek(cursor);
+    if (character == ']') {
+        
+        cursor->offset++;
+        return NO;
+    }
+    if (character == 0) {
+        
+        // Array has been truncated.
+        cursor->failed = YES;
+        return NO;
+    }
+    if (!*first) {
+        
+        if (character != ',') {
+            
+            cursor->failed = YES;
+            return NO;
+        }
+        cursor->offset++;
+    }
+    *first = NO;
+    
+    return (CNMVideoDecoderPeek(cursor) != 0);
+}
+
+/**
+ @brief  Read string which is next value.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return String or \c nil in case if next value is not string.
+ */
+static NSString *CNMVideoDecoderReadString(CNMVideoDecoderCursor *cursor) {
+    
+    NSUInteger start = 0;
+    NSUInteger length = 0;
+    BOOL hasEscapes = NO;
+    if (!CNMVideoDecoderScanString(cursor, &start, &length, &hasEscapes)) { return nil; }
+    if (!hasEscapes) {
+        
+        return [[NSString alloc] initWithBytes:(cursor->bytes + start) length:length encoding:NSUTF8StringEncoding];
+    }
+    
+    // Escape sequences are rare in fields used by data models, so they are handled by system de-serializer.
+    NSData *fragment = [NSData dataWithBytesNoCopy:(void *)(cursor->bytes + start - 1) length:(length + 2)
+                                      freeWhenDone:NO];
+    id string = [NSJSONSerialization JSONObjectWithData:fragment options:NSJSONReadingAllowFragments error:nil];
+    
+    return ([string isKindOfClass:NSString.class] ? string : nil);
+}
+
+/**
+ @brief  Read number which is next value.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return Number or \c nil in case if next value is not number.
+ */
+static NSNumber *CNMVideoDecoderReadNumber(CNMVideoDecoderCursor *cursor) {
+    
+    CNMVideoDecoderPeek(cursor);
+    NSUInteger start = cursor->offset;
+    BOOL isFloat = NO;
+    for (; cursor->offset < cursor->length; cursor->offset++) {
+        
+        uint8_t character = cursor->bytes[cursor->offset];
+        if (character == '.' || character == 'e' || character == 'E') { isFloat = YES; }
+        else if ((character < '0' || character > '9') && character != '-' && character != '+') { break; }
+    }
+    
+    char number[64];
+    NSUInteger length = cursor->offset - start;
+    if (length == 0 || length >= sizeof(number)) {
+        
+        cursor->offset = start;
+        CNMVideoDecoderSkipValue(cursor);
+        return nil;
+    }
+    
+    memcpy(number, cursor->bytes + start, length);
+    number[length] = '\0';
+    
+    return (isFloat ? @(strtod(number, NULL)) : @(strtoll(number, NULL, 10)));
+}
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMVideoDecoder ()
+
+
+#pragma mark - Properties
+
+/**
+ @brief      Stores reference on strings which has been interned so far.
+ @discussion Each key is string bytes from response body and value is string instance which should be used.
+ */
+@property (nonatomic) NSMutableDictionary<NSData *, NSString *> *internedStrings;
+
+/**
+ @brief  Stores device screen height which is used to pick up video image.
+ */
+@property (nonatomic, assign) CGFloat screenHeight;
+
+
+#pragma mark - Decoding
+
+/**
+ @brief  Decode video entry object which is next value.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return Decoded video entry or \c nil in case if next value is not object.
+ */
+- (CNMVideo *)videoFromCursor:(CNMVideoDecoderCursor *)cursor;
+
+/**
+ @brief      Decode value which is stored at nested key-path inside of next value.
+ @discussion All members which doesn't match to key-path components skipped.
+ 
+ @param cursor Reference on cursor inside of response body.
+ @param path   Reference on list of key-path components which is expected next.
+ @param length Number of components in \c path.
+ @param reader Reference on block which is used to decode value when all key-path components has been passed.
+ 
+ @return Decoded value or \c nil in case if next value doesn't have specified key-path.
+ */
+- (id)valueFromCursor:(CNMVideoDecoderCursor *)cursor atPath:(const CNMVideoDecoderFieldEntry *)path
+               length:(NSUInteger)length reader:(id(^)(void))reader;
+
+/**
+ @brief      Decode URL of video image which will best fit to device screen size.
+ @discussion Image is picked with same rules as \b CNMVideo use: smallest image which is higher than screen or
+             largest one.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return Suitable image URL string.
+ */
+- (NSString *)imageURLFromCursor:(CNMVideoDecoderCursor *)cursor;
+
+/**
+ @brief  Decode list of video presets which is next value.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return List of decoded video presets.
+ */
+- (NSArray<CNMVideoPreset *> *)presetsFromCursor:(CNMVideoDecoderCursor *)cursor;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Read string which is next value and replace it with previously interned instance.
+ 
+ @param cursor Reference on cursor inside of response body.
+ 
+ @return Interned string or \c nil in case if next value is not string.
+ */
+- (NSString *)internedStringFromCursor:(CNMVideoDecoderCursor *)cursor;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoDecoder
+
+
+#pragma mark - Initialization and Configuration
+
++ (void)initialize {
+    
+    if (self == [CNMVideoDecoder class]) { CNMVideoDecoderPrepareFields(); }
+}
+
++ (instancetype)decoder {
+    
+    return [self new];
+}
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _internedStrings = [NSMutableDictionary new];
+        _screenHeight = [UIScreen mainScreen].nativeBounds.size.height;
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Decoding
+
+- (CNMVideo *)videoFromData:(NSData *)data {
+    
+    CNMVideoDecoderCursor cursor = {.bytes = data.bytes, .length = data.length};
+    CNMVideo *video = [self videoFromCursor:&cursor];
+    
+    return (!cursor.failed ? video : nil);
+}
+
+- (NSArray<CNMVideo *> *)videosFromCollection:(NSString *)key inData:(NSData *)data {
+    
+    CNMVideoDecoderCursor cursor = {.bytes = data.bytes, .length = data.length};
+    CNMVideoDecoderFieldEntry collection = {.key = key.UTF8String, .length = strlen(key.UTF8String)};
+    NSMutableArray<CNMVideo *> *videos = nil;
+    if (CNMVideoDecoderEnterContainer(&cursor, '{')) {
+        
+        BOOL firstMember = YES;
+        const uint8_t *memberKey = NULL;
+        NSUInteger memberKeyLength = 0;
+        while (CNMVideoDecoderNextMember(&cursor, &firstMember, &memberKey, &memberKeyLength)) {
+            
+            if (collection.length == memberKeyLength && memcmp(collection.key, memberKey, memberKeyLength) == 0 &&
+                CNMVideoDecoderEnterContainer(&cursor, '[')) {
+                
+                BOOL firstElement = YES;
+                videos = [NSMutableArray new];
+                while (CNMVideoDecoderNextElement(&cursor, &firstElement)) {
+                    
+                    CNMVideo *video = [self videoFromCursor:&cursor];
+                    if (video) { [videos addObject:video]; }
+                }
+            }
+            else { CNMVideoDecoderSkipValue(&cursor); }
+        }
+    }
+    
+    return (!cursor.failed ? videos : nil);
+}
+
+- (CNMVideo *)videoFromCursor:(CNMVideoDecoderCursor *)cursor {
+    
+    if (!CNMVideoDecoderEnterContainer(cursor, '{')) { return nil; }
+    
+    CNMVideo *video = [CNMVideo new];
+    NSArray<CNMVideoPreset *> *presets = nil;
+    NSNumber *duration = nil;
+    BOOL firstMember = YES;
+    const uint8_t *key = NULL;
+    NSUInteger keyLength = 0;
+    while (CNMVideoDecoderNextMember(cursor, &firstMember, &key, &keyLength)) {
+        
+        switch (CNMVideoDecoderFieldForKey(CNMVideoDecoderVideoFields, 6, key, keyLength)) {
+            case CNMVideoDecoderIdentifierField:
+                video.identifier = [CNMVideo identifierFromData:CNMVideoDecoderReadString(cursor)];
+                break;
+            case CNMVideoDecoderImagesField:
+                video.imagePath = [self valueFromCursor:cursor atPath:CNMVideoDecoderImagesPath
+                                                 length:CNMVideoDecoderImagesPathLength
+                                                 reader:^id{ return [self imageURLFromCursor:cursor]; }];
+                break;
+            case CNMVideoDecoderNameField:
+                video.name = CNMVideoDecoderReadString(cursor);
+                break;
+            case CNMVideoDecoderDurationField:
+                duration = CNMVideoDecoderReadNumber(cursor);
+                break;
+            case CNMVideoDecoderCreationDateField:
+                // Stored in same representation as dictionary mapping does.
+                video.creationDate = (id)CNMVideoDecoderReadString(cursor);
+                break;
+            case CNMVideoDecoderPresetsField:
+                presets = [self presetsFromCursor:cursor];
+                break;
+            default:
+                CNMVideoDecoderSkipValue(cursor);
+                break;
+        }
+    }
+    
+    // Presets reference on video which is known only when whole object has been processed. Feed pages doesn't
+    // have presets, so they left unset and won't replace presets which has been fetched for stored entry.
+    for (CNMVideoPreset *preset in presets) {
+        
+        preset.video = video.identifier;
+        preset.duration = duration;
+    }
+    video.presets = presets;
+    
+    return (!cursor->failed ? video : nil);
+}
+
+- (id)valueFromCursor:(CNMVideoDecoderCursor *)cursor atPath:(const CNMVideoDecoderFieldEntry *)path
+               length:(NSUInteger)length reader:(id(^)(void))reader {
+    
+    if (length == 0) { return reader(); }
+    
+    id value = nil;
+    if (CNMVideoDecoderEnterContainer(cursor, '{')) {
+        
+        BOOL first = YES;
+        const uint8_t *key = NULL;
+        NSUInteger keyLength = 0;
+        while (CNMVideoDecoderNextMember(cursor, &first, &key, &keyLength)) {
+            
+            if (CNMVideoDecoderFieldForKey(path, 1, key, keyLength)) {
+                
+                value = [self valueFromCursor:cursor atPath:(path + 1) length:(length - 1) reader:reader];
+            }
+            else { CNMVideoDecoderSkipValue(cursor); }
+        }
+    }
+    
+    return value;
+}
+
+- (NSString *)imageURLFromCursor:(CNMVideoDecoderCursor *)cursor {
+    
+    const uint8_t *key = NULL;
+    NSUInteger keyLength = 0;
+    NSString *closestURL = nil;
+    NSString *largestURL = nil;
+    CGFloat closestHeight = CGFLOAT_MAX;
+    CGFloat largestHeight = 0.0f;
+    if (CNMVideoDecoderEnterContainer(cursor, '[')) {
+        
+        BOOL firstElement = YES;
+        while (CNMVideoDecoderNextElement(cursor, &firstElement)) {
+            
+            if (!CNMVideoDecoderEnterContainer(cursor, '{')) { continue; }
+            
+            CGFloat height = 0.0f;
+            NSString *url = nil;
+            BOOL first = YES;
+            while (CNMVideoDecoderNextMember(cursor, &first, &key, &keyLength)) {
+                
+                switch (CNMVideoDecoderFieldForKey(CNMVideoDecoderImageFields, 2, key, keyLength)) {
+                    case CNMVideoDecoderImageHeightField:
+                        height = CNMVideoDecoderReadNumber(cursor).doubleValue;
+                        break;
+                    case CNMVideoDecoderImageURLField:
+                        url = CNMVideoDecoderReadString(cursor);
+                        break;
+                    default:
+                        CNMVideoDecoderSkipValue(cursor);
+                        break;
+                }
+            }
+            
+            if (height > self.screenHeight && height < closestHeight) {
+                
+                closestURL = url;
+                closestHeight = height;
+            }
+            if (height > largestHeight) {
+                
+                largestURL = url;
+                largestHeight = height;
+            }
+        }
+    }
+    
+    return (closestURL ?: largestURL);
+}
+
+- (NSArray<CNMVideoPreset *> *)presetsFromCursor:(CNMVideoDecoderCursor *)cursor {
+    
+    NSMutableArray<CNMVideoPreset *> *presets = [NSMutableArray new];
+    if (CNMVideoDecoderEnterContainer(cursor, '[')) {
+        
+        BOOL firstElement = YES;
+        while (CNMVideoDecoderNextElement(cursor, &firstElement)) {
+            
+            if (!CNMVideoDecoderEnterContainer(cursor, '{')) { continue; }
+            
+            CNMVideoPreset *preset = [CNMVideoPreset new];
+            BOOL firstMember = YES;
+            const uint8_t *key = NULL;
+            NSUInteger keyLength = 0;
+            while (CNMVideoDecoderNextMember(cursor, &firstMember, &key, &keyLength)) {
+                
+                switch (CNMVideoDecoderFieldForKey(CNMVideoDecoderPresetFields, 5, key, keyLength)) {
+                    case CNMVideoDecoderPresetWidthField:
+                        preset.width = CNMVideoDecoderReadNumber(cursor);
+                        break;
+                    case CNMVideoDecoderPresetHeightField:
+                        preset.height = CNMVideoDecoderReadNumber(cursor);
+                        break;
+                    case CNMVideoDecoderPresetSizeField:
+                        preset.size = CNMVideoDecoderReadNumber(cursor);
+                        break;
+                    case CNMVideoDecoderPresetURLField:
+                        preset.url = CNMVideoDecoderReadString(cursor);
+                        break;
+                    case CNMVideoDecoderPresetQualityField:
+                        preset.quality = [self internedStringFromCursor:cursor];
+                        break;
+                    default:
+                        CNMVideoDecoderSkipValue(cursor);
+                        break;
+                }
+            }
+            [presets addObject:preset];
+        }
+    }
+    
+    return presets;
+}
+
+
+#pragma mark - Misc
+
+- (NSString *)internedStringFromCursor:(CNMVideoDecoderCursor *)cursor {
+    
+    NSUInteger start = cursor->offset;
+    NSUInteger length = 0;
+    BOOL hasEscapes = NO;
+    if (!CNMVideoDecoderScanString(cursor, &start, &length, &hasEscapes)) { return nil; }
+    if (hasEscapes) {
+        
+        cursor->offset = start - 1;
+        return CNMVideoDecoderReadString(cursor);
+    }
+    
+    // Lookup key reference response body bytes, so copy is done only for strings which is seen first time.
+    NSData *bytes = [NSData dataWithBytesNoCopy:(void *)(cursor->bytes + start) length:length freeWhenDone:NO];
+    NSString *string = self.internedStrings[bytes];
+    if (!string) {
+        
+        string = [[NSString alloc] initWithBytes:bytes.bytes length:length encoding:NSUTF8StringEncoding];
+        if (string) { self.internedStrings[[NSData dataWithBytes:bytes.bytes length:length]] = string; }
+    }
+    
+    return string;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,117 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMVideo;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Ordered index of video feed entries.
+ @discussion Entries kept sorted by \c idx (from newest to oldest) on insertion, so there is no need to sort
+             them each time when feed should be shown. Position for new entry found with binary search over
+             unboxed \c idx values and entries from next feed pages (which is older than stored) appended w/o
+             search at all.
+             Instance is not thread-safe and should be used from single serial queue. Snapshot lists can be
+             passed to any queue.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoFeedIndex : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores how many entries stored in index.
+ */
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+/**
+ @brief  Stores reference on newest entry (entry with largest \c idx).
+ */
+@property (nonatomic, nullable, readonly, strong) CNMVideo *firstEntry;
+
+/**
+ @brief  Stores reference on oldest entry (entry with smallest \c idx).
+ */
+@property (nonatomic, nullable, readonly, strong) CNMVideo *lastEntry;
+
+/**
+ @brief      Stores reference on immutable list of entries sorted by \c idx from newest to oldest.
+ @discussion Same list instance returned until index will be modified, so it can be requested as often as
+             required.
+ */
+@property (nonatomic, readonly, copy) NSArray<CNMVideo *> *snapshot;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure empty feed index.
+ 
+ @return Configured and ready to use index.
+ */
++ (instancetype)index;
+
+
+///------------------------------------------------
+/// @name Entries
+///------------------------------------------------
+
+/**
+ @brief  Retrieve entry by it's identifier.
+ 
+ @param identifier Video identifier on remote data provider.
+ 
+ @return Stored entry or \c nil in case if there is no entry with specified identifier.
+ */
+- (nullable CNMVideo *)entryWithIdentifier:(NSString *)identifier;
+
+/**
+ @brief  Find position of entry in list of sorted entries.
+ 
+ @param video Reference on video entry for which position should be found.
+ 
+ @return Entry position or \c NSNotFound in case if entry not stored in index.
+ */
+- (NSUInteger)indexOfEntry:(CNMVideo *)video;
+
+/**
+ @brief  Store entry in position which correspond to it's \c idx.
+ 
+ @param video Reference on video entry which should be stored.
+ 
+ @return \c NO in case if entry with same identifier already stored.
+ */
+- (BOOL)addEntry:(CNMVideo *)video;
+
+/**
+ @brief      Replace stored entry with it's updated copy.
+ @discussion Entries which has been passed with snapshot can be used on other queue, so changes applied to copy
+             which replace original entry at same position.
+ 
+ @param video        Reference on video entry which is stored in index.
+ @param updatedVideo Reference on updated copy of \c video (should have same identifier and \c idx).
+ */
+- (void)replaceEntry:(CNMVideo *)video withEntry:(CNMVideo *)updatedVideo;
+
+/**
+ @brief  Remove all entries from index.
+ */
+- (void)removeAllEntries;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,220 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoFeedIndex.h"
+#import "CNMVideo.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores initial number of \c idx values for which storage should be allocated.
+ */
+static NSUInteger const kCNMVideoFeedIndexInitialCapacity = 32;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMVideoFeedIndex () {
+    
+    /**
+     @brief  Stores unboxed \c idx values in same order as \c entries.
+     */
+    NSUInteger *_keys;
+    
+    /**
+     @brief  Stores number of \c idx values for which \c _keys has been allocated.
+     */
+    NSUInteger _capacity;
+}
+
+
+#pragma mark - Properties
+
+@property (nonatomic, copy) NSArray<CNMVideo *> *snapshot;
+
+/**
+ @brief  Stores reference on entries sorted by \c idx from newest to oldest.
+ */
+@property (nonatomic) NSMutableArray<CNMVideo *> *entries;
+
+/**
+ @brief  Stores reference on dictionary where each key is video identifier and value is stored entry.
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, CNMVideo *> *entriesByIdentifier;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Find position at which entry with specified \c idx should be stored.
+ 
+ @param idx Entry index in feed.
+ 
+ @return Position after all entries which has same or bigger \c idx.
+ */
+- (NSUInteger)positionForIdx:(NSUInteger)idx;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoFeedIndex
+
+
+#pragma mark - Information
+
+- (NSUInteger)count {
+    
+    return self.entries.count;
+}
+
+- (CNMVideo *)firstEntry {
+    
+    return self.entries.firstObject;
+}
+
+- (CNMVideo *)lastEntry {
+    
+    return self.entries.lastObject;
+}
+
+- (NSArray<CNMVideo *> *)snapshot {
+    
+    if (!_snapshot) { _snapshot = [self.entries copy]; }
+    
+    return _snapshot;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)index {
+    
+    return [self new];
+}
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _entries = [NSMutableArray new];
+        _entriesByIdentifier = [NSMutableDictionary new];
+        _capacity = kCNMVideoFeedIndexInitialCapacity;
+        _keys = malloc(_capacity * sizeof(NSUInteger));
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Entries
+
+- (CNMVideo *)entryWithIdentifier:(NSString *)identifier {
+    
+    return self.entriesByIdentifier[identifier];
+}
+
+- (NSUInteger)indexOfEntry:(CNMVideo *)video {
+    
+    NSUInteger idx = video.idx.unsignedIntegerValue;
+    NSUInteger count = self.entries.count;
+    NSUInteger lowerBound = 0;
+    NSUInteger upperBound = count;
+    while (lowerBound < upperBound) {
+        
+        NSUInteger middle = lowerBound + (upperBound - lowerBound) / 2;
+        if (_keys[middle] > idx) { lowerBound = middle + 1; }
+        else { upperBound = middle; }
+    }
+    
+    // Few entries may have same idx.
+    for (NSUInteger position = lowerBound; position < count && _keys[position] == idx; position++) {
+        
+        if (self.entries[position] == video) { return position; }
+    }
+    
+    return NSNotFound;
+}
+
+- (BOOL)addEntry:(CNMVideo *)video {
+    
+    if (!video.identifier || self.entriesByIdentifier[video.identifier]) { return NO; }
+    
+    NSUInteger count = self.entries.count;
+    if (count == _capacity) {
+        
+        _capacity *= 2;
+        _keys = realloc(_keys, _capacity * sizeof(NSUInteger));
+    }
+    
+    NSUInteger idx = video.idx.unsignedIntegerValue;
+    NSUInteger position = [self positionForIdx:idx];
+    if (position < count) {
+        
+        memmove(&_keys[position + 1], &_keys[position], (count - position) * sizeof(NSUInteger));
+    }
+    _keys[position] = idx;
+    [self.entries insertObject:video atIndex:position];
+    self.entriesByIdentifier[video.identifier] = video;
+    _snapshot = nil;
+    
+    return YES;
+}
+
+- (void)replaceEntry:(CNMVideo *)video withEntry:(CNMVideo *)updatedVideo {
+    
+    NSUInteger position = [self indexOfEntry:video];
+    if (position != NSNotFound) {
+        
+        self.entries[position] = updatedVideo;
+        self.entriesByIdentifier[updatedVideo.identifier] = updatedVideo;
+        _snapshot = nil;
+    }
+}
+
+- (void)removeAllEntries {
+    
+    [self.entries removeAllObjects];
+    [self.entriesByIdentifier removeAllObjects];
+    _snapshot = nil;
+}
+
+
+#pragma mark - Misc
+
+- (NSUInteger)positionForIdx:(NSUInteger)idx {
+    
+    NSUInteger count = self.entries.count;
+    
+    // Entries from next feed pages is older than all stored.
+    if (count == 0 || _keys[count - 1] >= idx) { return count; }
+    
+    NSUInteger lowerBound = 0;
+    NSUInteger upperBound = count;
+    while (lowerBound < upperBound) {
+        
+        NSUInteger middle = lowerBound + (upperBound - lowerBound) / 2;
+        if (_keys[middle] >= idx) { lowerBound = middle + 1; }
+        else { upperBound = middle; }
+    }
+    
+    return lowerBound;
+}
+
+- (void)dealloc {
+    
+    free(_keys);
+}
+
+#pragma mark -
+
+
+@end
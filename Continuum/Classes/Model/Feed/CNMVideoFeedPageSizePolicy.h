@@ -0,0 +1,78 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Video feed page size policy.
+ @discussion First feed page is small, so it arrive as fast as possible. Size of next pages calculated from
+             measured request latency and how fast user consume feed entries: page should contain enough entries
+             to let user watch them while next page is fetching.
+             Remote data provider paginate feed with page index and page size, so page size always is divisor
+             of feed offset at which page should start. Because of this sizes picked from powers of two and
+             each page start exactly after last fetched entry even when page size has been changed.
+             Instance is not thread-safe and should be used from single serial queue (feed manager use it
+             from it's state queue).
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoFeedPageSizePolicy : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores smoothed feed page request latency (in seconds).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval latency;
+
+/**
+ @brief  Stores smoothed number of feed entries which user consume per second.
+ */
+@property (nonatomic, readonly, assign) double consumptionRate;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure page size policy.
+ 
+ @return Configured and ready to use policy.
+ */
++ (instancetype)policy;
+
+
+///------------------------------------------------
+/// @name Page size
+///------------------------------------------------
+
+/**
+ @brief  Calculate size of feed page which should be fetched next.
+ 
+ @param offset Number of feed entries (from newest) which has been fetched before page which should be
+               requested (\c 0 for first page).
+ 
+ @return Number of entries which should be requested. Returned value always is divisor of \c offset.
+ */
+- (NSUInteger)pageSizeForOffset:(NSUInteger)offset;
+
+/**
+ @brief  Store information about completed feed page request.
+ 
+ @param size    Number of entries which has been requested.
+ @param latency How long it took to fetch page (in seconds).
+ */
+- (void)recordPageOfSize:(NSUInteger)size fetchedWithLatency:(NSTimeInterval)latency;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,140 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoFeedPageSizePolicy.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores number of entries which should be requested with first feed page.
+ */
+static NSUInteger const kCNMInitialPageSize = 4;
+
+/**
+ @brief  Stores minimum and maximum number of entries which can be requested with next feed pages.
+ */
+static NSUInteger const kCNMMinimumPageSize = 8;
+static NSUInteger const kCNMMaximumPageSize = 64;
+
+/**
+ @brief  Stores for how many request latencies fetched page should be enough for user.
+ */
+static double const kCNMPageLatencyCoverage = 3.0f;
+
+/**
+ @brief  Stores weight of new measurement in smoothed latency and consumption rate values.
+ */
+static double const kCNMMeasurementWeight = 0.3f;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMVideoFeedPageSizePolicy ()
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSTimeInterval latency;
+@property (nonatomic, assign) double consumptionRate;
+
+/**
+ @brief  Stores feed offset at which previous next page has been requested.
+ */
+@property (nonatomic, assign) NSUInteger lastRequestOffset;
+
+/**
+ @brief  Stores when previous next page has been requested.
+ */
+@property (nonatomic, assign) CFAbsoluteTime lastRequestDate;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Update smoothed value with new measurement.
+ 
+ @param value       Current smoothed value (\c 0 if there is no measurements yet).
+ @param measurement New measured value.
+ 
+ @return Updated smoothed value.
+ */
+- (double)smoothedValue:(double)value withMeasurement:(double)measurement;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoFeedPageSizePolicy
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)policy {
+    
+    return [self new];
+}
+
+
+#pragma mark - Page size
+
+- (NSUInteger)pageSizeForOffset:(NSUInteger)offset {
+    
+    if (offset == 0) { return kCNMInitialPageSize; }
+    
+    // Time between next page requests show how fast user consumed entries from previously fetched pages.
+    CFAbsoluteTime requestDate = CFAbsoluteTimeGetCurrent();
+    if (self.lastRequestDate > 0.0f && offset > self.lastRequestOffset && requestDate > self.lastRequestDate) {
+        
+        double rate = (offset - self.lastRequestOffset) / (requestDate - self.lastRequestDate);
+        self.consumptionRate = [self smoothedValue:self.consumptionRate withMeasurement:rate];
+    }
+    self.lastRequestOffset = offset;
+    self.lastRequestDate = requestDate;
+    
+    NSUInteger size = kCNMMinimumPageSize;
+    double requiredEntries = self.consumptionRate * self.latency * kCNMPageLatencyCoverage;
+    while (size < kCNMMaximumPageSize && size < requiredEntries) { size *= 2; }
+    
+    // Page should start right after last fetched entry.
+    while (offset % size != 0) { size /= 2; }
+    if (size < kCNMInitialPageSize) {
+        
+        // Offset has been reached with page sizes which isn't power of two (from previous versions).
+        size = MIN(offset, kCNMMaximumPageSize);
+        while (offset % size != 0) { size--; }
+    }
+    
+    return size;
+}
+
+- (void)recordPageOfSize:(NSUInteger)size fetchedWithLatency:(NSTimeInterval)latency {
+    
+    self.latency = [self smoothedValue:self.latency withMeasurement:latency];
+#if DEBUG
+    NSLog(@"<Continuum::Paging> Page with %lu entries fetched in %.2f ms (latency: %.2f ms, consumption: "
+          "%.2f entries/s)", (unsigned long)size, latency * 1000.0f, self.latency * 1000.0f,
+          self.consumptionRate);
+#endif
+}
+
+
+#pragma mark - Misc
+
+- (double)smoothedValue:(double)value withMeasurement:(double)measurement {
+    
+    if (value <= 0.0f) { return measurement; }
+    
+    return (value + (measurement - value) * kCNMMeasurementWeight);
+}
+
+#pragma mark -
+
+
+@end
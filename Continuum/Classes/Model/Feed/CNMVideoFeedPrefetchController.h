@@ -0,0 +1,106 @@
+#import <UIKit/UIKit.h>
+
+
+#pragma mark Class forward
+
+@class CNMVideoFeedManager, CNMVideo;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Video feed next page prefetch controller.
+ @discussion Controller track which feed entry is visible and how fast user scroll through feed to request next
+             feed page before user will reach end of the feed. Requested page is cancelled if user scroll back
+             far enough from the end of the feed.
+             Instance is not thread-safe and should be used from main queue.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoFeedPrefetchController : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores how many entries before the end of the feed next page should be requested.
+ @note   Default value is \c 2.
+ */
+@property (nonatomic, assign) NSUInteger prefetchDistance;
+
+/**
+ @brief  Stores whether next feed page is fetching at this moment or not.
+ */
+@property (nonatomic, readonly, assign, getter = isFetching) BOOL fetching;
+
+/**
+ @brief  Stores how many next feed pages has been requested.
+ */
+@property (nonatomic, readonly, assign) NSUInteger fetchCount;
+
+/**
+ @brief  Stores how many times user reached end of the feed and loading entry has been shown.
+ */
+@property (nonatomic, readonly, assign) NSUInteger loadingEntryShowCount;
+
+/**
+ @brief  Stores reference on block which is called on main queue when next feed page fetch has been completed
+         (not called for cancelled fetches).
+ */
+@property (nonatomic, nullable, copy) void(^pageLoadHandler)(NSArray<CNMVideo *> *feed, NSError * _Nullable error);
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure prefetch controller.
+ 
+ @param manager Reference on manager which should be used to fetch next feed pages.
+ 
+ @return Configured and ready to use prefetch controller.
+ */
++ (instancetype)controllerWithFeedManager:(CNMVideoFeedManager *)manager;
+
+
+///------------------------------------------------
+/// @name Prefetch
+///------------------------------------------------
+
+/**
+ @brief      Update prefetch state using current feed scroll position.
+ @discussion Faster user scroll towards older entries, earlier next page will be requested.
+ 
+ @param index    Index of entry which is (or will be) visible.
+ @param count    How many entries is in feed at this moment.
+ @param velocity Scroll velocity in entries per second (positive while user scroll towards older entries).
+ */
+- (void)updateForVisibleEntryAtIndex:(NSUInteger)index ofEntriesCount:(NSUInteger)count
+                            velocity:(CGFloat)velocity;
+
+/**
+ @brief  Request next feed page if it's not fetching at this moment.
+ */
+- (void)fetchNextPage;
+
+/**
+ @brief  Cancel next feed page fetch if it's active at this moment.
+ */
+- (void)cancel;
+
+/**
+ @brief  Handle loading entry appearance (user reached end of the feed before next page has been fetched).
+ */
+- (void)handleLoadingEntryShow;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,172 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoFeedPrefetchController.h"
+#import "CNMVideoFeedManager.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores default number of entries before the end of the feed at which next page should be requested.
+ */
+static NSUInteger const kCNMDefaultPrefetchDistance = 2;
+
+/**
+ @brief  Stores for how long (in seconds) scroll velocity should be extrapolated to find out how many entries
+         user will pass while next page is fetching.
+ */
+static CGFloat const kCNMPrefetchLookaheadInterval = 1.0f;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMVideoFeedPrefetchController ()
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign, getter = isFetching) BOOL fetching;
+@property (nonatomic, assign) NSUInteger fetchCount;
+@property (nonatomic, assign) NSUInteger loadingEntryShowCount;
+
+/**
+ @brief  Stores reference on manager which is used to fetch next feed pages.
+ */
+@property (nonatomic, weak) CNMVideoFeedManager *feedManager;
+
+/**
+ @brief  Stores identifier of last started fetch which is used to ignore completion of cancelled fetches.
+ */
+@property (nonatomic, assign) NSUInteger fetchIdentifier;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize prefetch controller.
+ 
+ @param manager Reference on manager which should be used to fetch next feed pages.
+ 
+ @return Initialized and ready to use prefetch controller.
+ */
+- (instancetype)initWithFeedManager:(CNMVideoFeedManager *)manager;
+
+
+#pragma mark - Handlers
+
+/**
+ @brief  Handle next feed page fetch completion.
+ 
+ @param identifier Identifier of fetch which has been completed.
+ @param feed       List of all fetched video entries.
+ @param error      Reference on fetch error (if any).
+ */
+- (void)handleFetch:(NSUInteger)identifier completionWithFeed:(NSArray<CNMVideo *> *)feed
+              error:(nullable NSError *)error;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoFeedPrefetchController
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)controllerWithFeedManager:(CNMVideoFeedManager *)manager {
+    
+    return [[self alloc] initWithFeedManager:manager];
+}
+
+- (instancetype)initWithFeedManager:(CNMVideoFeedManager *)manager {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _feedManager = manager;
+        _prefetchDistance = kCNMDefaultPrefetchDistance;
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Prefetch
+
+- (void)updateForVisibleEntryAtIndex:(NSUInteger)index ofEntriesCount:(NSUInteger)count
+                            velocity:(CGFloat)velocity {
+    
+    NSUInteger entriesLeft = (index + 1 < count ? count - index - 1 : 0);
+    NSUInteger distance = self.prefetchDistance;
+    if (velocity > 0.0f) { distance += (NSUInteger)ceil(velocity * kCNMPrefetchLookaheadInterval); }
+    
+    if (entriesLeft <= distance) { [self fetchNextPage]; }
+    else if (self.isFetching && velocity <= 0.0f && entriesLeft > self.prefetchDistance * 2) {
+        
+        // User scrolled back towards newer entries and won't reach end of the feed soon.
+        [self cancel];
+    }
+}
+
+- (void)fetchNextPage {
+    
+    if (!self.isFetching) {
+        
+        self.fetching = YES;
+        self.fetchCount++;
+        NSUInteger identifier = ++self.fetchIdentifier;
+        __weak __typeof__(self) weakSelf = self;
+        [self.feedManager fetchNextFeedPageWithCompletion:^(NSArray<CNMVideo *> *feed, NSError *error) {
+            
+            [weakSelf handleFetch:identifier completionWithFeed:feed error:error];
+        }];
+    }
+}
+
+- (void)cancel {
+    
+    if (self.isFetching) {
+        
+        self.fetching = NO;
+        self.fetchIdentifier++;
+        [self.feedManager cancelNextFeedPageFetch];
+    }
+}
+
+- (void)handleLoadingEntryShow {
+    
+    self.loadingEntryShowCount++;
+#if DEBUG
+    NSLog(@"<Continuum::Prefetch> Loading entry shown %lu times for %lu page fetches",
+          (unsigned long)self.loadingEntryShowCount, (unsigned long)self.fetchCount);
+#endif
+    [self fetchNextPage];
+    
+    // User is waiting for next page, so it shouldn't wait for less important requests.
+    [self.feedManager prioritizeNextFeedPageFetch];
+}
+
+
+#pragma mark - Handlers
+
+- (void)handleFetch:(NSUInteger)identifier completionWithFeed:(NSArray<CNMVideo *> *)feed
+              error:(NSError *)error {
+    
+    // Fetch has been cancelled.
+    if (identifier != self.fetchIdentifier) { return; }
+    
+    self.fetching = NO;
+    if (self.pageLoadHandler) { self.pageLoadHandler(feed, error); }
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,122 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMVideo;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Persistent binary snapshot of video feed which allow to show feed right after application launch.
+ @discussion Snapshot file start with format signature and version which is followed by tagged records (tag,
+             length and value). Readers skip records with unknown tags, so new data model fields can be added
+             w/o version change and stored snapshot still can be used. Version should be changed only in case
+             if layout of known records has been changed (snapshot with different version is ignored).
+             File is memory-mapped on load, so only data which is used by data models read from disk.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoFeedSnapshot : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores how long it took to load entries from stored snapshot (in seconds).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval loadDuration;
+
+/**
+ @brief  Stores size of last loaded or stored snapshot in bytes.
+ */
+@property (nonatomic, readonly, assign) unsigned long long size;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure snapshot which will be stored in file with specified name.
+ 
+ @param name Name of file inside of application's caches directory.
+ 
+ @return Configured and ready to use snapshot.
+ */
++ (instancetype)snapshotWithName:(NSString *)name;
+
+
+///------------------------------------------------
+/// @name Storage
+///------------------------------------------------
+
+/**
+ @brief  Load video entries from stored snapshot.
+ 
+ @param count Reference on pointer where number of entries which remote data provider is able to return should
+              be stored.
+ 
+ @return List of video entries in same order as they has been stored or \c nil in case if there is no snapshot
+         or it can't be used.
+ */
+- (nullable NSArray<CNMVideo *> *)loadEntriesWithTotalEntriesCount:(NSUInteger *)count;
+
+/**
+ @brief      Store video entries.
+ @discussion Entries encoded on calling queue (data models is not thread-safe) and written to the disk on
+             background queue.
+ 
+ @param entries List of video entries which should be stored.
+ @param count   Number of entries which remote data provider is able to return.
+ */
+- (void)storeEntries:(NSArray<CNMVideo *> *)entries totalEntriesCount:(NSUInteger)count;
+
+/**
+ @brief      Store video entries which already has been encoded.
+ @discussion Records written to the disk on background queue.
+ 
+ @param records List of video entry records (created with \c +recordForEntry:) which should be stored.
+ @param count   Number of entries which remote data provider is able to return.
+ */
+- (void)storeEntryRecords:(NSArray<NSData *> *)records totalEntriesCount:(NSUInteger)count;
+
+/**
+ @brief  Remove stored snapshot.
+ */
+- (void)removeStoredEntries;
+
+
+///------------------------------------------------
+/// @name Records
+///------------------------------------------------
+
+/**
+ @brief  Encode video entry into record which is used by snapshot.
+ 
+ @param video Reference on video entry which should be encoded.
+ 
+ @return Binary representation of video entry records.
+ */
++ (NSData *)recordForEntry:(CNMVideo *)video;
+
+/**
+ @brief  Decode video entry from record which is used by snapshot.
+ 
+ @param record Reference on binary representation of video entry records.
+ 
+ @return Decoded video entry or \c nil in case if record doesn't have identifier.
+ */
++ (nullable CNMVideo *)entryFromRecord:(NSData *)record;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,466 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoFeedSnapshot.h"
+#import "CNMVideoPreset+Private.h"
+#import "CNMVideo+Private.h"
+
+
+#pragma mark Types
+
+/**
+ @brief  Tags of records which can be stored in snapshot.
+ */
+typedef NS_ENUM(uint8_t, CNMVideoFeedSnapshotTag) {
+    
+    /**
+     @brief  Root level records.
+     */
+    CNMVideoFeedSnapshotTotalCountTag = 1,
+    CNMVideoFeedSnapshotEntryTag = 2,
+    
+    /**
+     @brief  Video entry records.
+     */
+    CNMVideoFeedSnapshotIdentifierTag = 16,
+    CNMVideoFeedSnapshotIdxTag = 17,
+    CNMVideoFeedSnapshotNameTag = 18,
+    CNMVideoFeedSnapshotAuthorTag = 19,
+    CNMVideoFeedSnapshotImagePathTag = 20,
+    CNMVideoFeedSnapshotCreationDateTag = 21,
+    CNMVideoFeedSnapshotPresetTag = 22,
+    
+    /**
+     @brief  Video preset records.
+     */
+    CNMVideoFeedSnapshotPresetWidthTag = 32,
+    CNMVideoFeedSnapshotPresetHeightTag = 33,
+    CNMVideoFeedSnapshotPresetSizeTag = 34,
+    CNMVideoFeedSnapshotPresetURLTag = 35,
+    CNMVideoFeedSnapshotPresetDurationTag = 36,
+    CNMVideoFeedSnapshotPresetQualityTag = 37
+};
+
+
+#pragma mark - Static
+
+/**
+ @brief  Stores signature which is stored at the beginning of snapshot file.
+ */
+static char const kCNMVideoFeedSnapshotSignature[4] = {'C', 'N', 'M', 'F'};
+
+/**
+ @brief  Stores version of records layout.
+ */
+static uint16_t const kCNMVideoFeedSnapshotVersion = 1;
+
+/**
+ @brief  Stores length of snapshot header (signature and version).
+ */
+static NSUInteger const kCNMVideoFeedSnapshotHeaderLength = 6;
+
+/**
+ @brief  Stores length of record tag and value length fields.
+ */
+static NSUInteger const kCNMVideoFeedSnapshotRecordHeaderLength = 5;
+
+
+#pragma mark - Encoding
+
+/**
+ @brief  Append record with raw value.
+ 
+ @param data   Reference on buffer to which record should be appended.
+ @param tag    Record tag.
+ @param value  Pointer on record value bytes.
+ @param length Length of record value in bytes.
+ */
+static void CNMVideoFeedSnapshotAppendRecord(NSMutableData *data, CNMVideoFeedSnapshotTag tag, const void *value,
+                                             NSUInteger length) {
+    
+    uint32_t valueLength = CFSwapInt32HostToBig((uint32_t)length);
+    [data appendBytes:&tag length:sizeof(tag)];
+    [data appendBytes:&valueLength length:sizeof(valueLength)];
+    if (length) { [data appendBytes:value length:length]; }
+}
+
+/**
+ @brief  Append record with string value.
+ 
+ @param data   Reference on buffer to which record should be appended.
+ @param tag    Record tag.
+ @param string Reference on string which should be stored (record is skipped if it is not string).
+ */
+static void CNMVideoFeedSnapshotAppendString(NSMutableData *data, CNMVideoFeedSnapshotTag tag, id string) {
+    
+    if ([string isKindOfClass:NSString.class]) {
+        
+        NSUInteger length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        CNMVideoFeedSnapshotAppendRecord(data, tag, ((NSString *)string).UTF8String, length);
+    }
+}
+
+/**
+ @brief  Append record with numeric value.
+ 
+ @param data   Reference on buffer to which record should be appended.
+ @param tag    Record tag.
+ @param number Reference on number which should be stored (record is skipped if it is not number).
+ */
+static void CNMVideoFeedSnapshotAppendNumber(NSMutableData *data, CNMVideoFeedSnapshotTag tag, id number) {
+    
+    if ([number isKindOfClass:NSNumber.class]) {
+        
+        CFSwappedFloat64 value = CFConvertDoubleHostToSwapped(((NSNumber *)number).doubleValue);
+        CNMVideoFeedSnapshotAppendRecord(data, tag, &value, sizeof(value));
+    }
+}
+
+
+#pragma mark - Decoding
+
+/**
+ @brief  Read next record.
+ 
+ @param bytes  Pointer on bytes from which record should be read.
+ @param length Length of \c bytes.
+ @param offset Reference on offset from which record starts. Offset moved to the next record.
+ @param tag    Reference on pointer where record tag should be stored.
+ @param value  Reference on pointer where pointer on record value should be stored.
+ @param size   Reference on pointer where record value length should be stored.
+ 
+ @return \c NO in case if there is no more complete records.
+ */
+static BOOL CNMVideoFeedSnapshotNextRecord(const uint8_t *bytes, NSUInteger length, NSUInteger *offset,
+                                           CNMVideoFeedSnapshotTag *tag, const uint8_t **value, NSUInteger *size) {
+    
+    if (*offset + kCNMVideoFeedSnapshotRecordHeaderLength > length) { return NO; }
+    
+    uint32_t valueLength = 0;
+    memcpy(&valueLength, bytes + *offset + 1, sizeof(valueLength));
+    valueLength = CFSwapInt32BigToHost(valueLength);
+    if (*offset + kCNMVideoFeedSnapshotRecordHeaderLength + valueLength > length) { return NO; }
+    
+    *tag = bytes[*offset];
+    *value = bytes + *offset + kCNMVideoFeedSnapshotRecordHeaderLength;
+    *size = valueLength;
+    *offset += kCNMVideoFeedSnapshotRecordHeaderLength + valueLength;
+    
+    return YES;
+}
+
+/**
+ @brief  Decode string record value.
+ 
+ @param value Pointer on record value.
+ @param size  Record value length.
+ 
+ @return Decoded string.
+ */
+static NSString *CNMVideoFeedSnapshotString(const uint8_t *value, NSUInteger size) {
+    
+    return [[NSString alloc] initWithBytes:value length:size encoding:NSUTF8StringEncoding];
+}
+
+/**
+ @brief  Decode numeric record value.
+ 
+ @param value Pointer on record value.
+ @param size  Record value length.
+ 
+ @return Decoded number or \c nil in case if record has unexpected length.
+ */
+static NSNumber *CNMVideoFeedSnapshotNumber(const uint8_t *value, NSUInteger size) {
+    
+    if (size != sizeof(CFSwappedFloat64)) { return nil; }
+    
+    CFSwappedFloat64 number;
+    memcpy(&number, value, sizeof(number));
+    double hostNumber = CFConvertDoubleSwappedToHost(number);
+    
+    return (hostNumber == floor(hostNumber) ? @((long long)hostNumber) : @(hostNumber));
+}
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMVideoFeedSnapshot ()
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSTimeInterval loadDuration;
+@property (nonatomic, assign) unsigned long long size;
+
+/**
+ @brief  Stores reference on full path to the snapshot file.
+ */
+@property (nonatomic, copy) NSString *filePath;
+
+/**
+ @brief  Stores reference on serial queue which is used to write snapshot to the disk.
+ */
+@property (nonatomic) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize snapshot which will be stored in file with specified name.
+ 
+ @param name Name of file inside of application's caches directory.
+ 
+ @return Initialized and ready to use snapshot.
+ */
+- (instancetype)initWithName:(NSString *)name;
+
+
+#pragma mark - Records
+
+/**
+ @brief  Decode video entry.
+ 
+ @param bytes  Pointer on video entry records.
+ @param length Length of \c bytes.
+ 
+ @return Decoded video entry or \c nil in case if entry doesn't have identifier.
+ */
++ (CNMVideo *)entryFromBytes:(const uint8_t *)bytes length:(NSUInteger)length;
+
+/**
+ @brief  Decode video preset.
+ 
+ @param bytes  Pointer on video preset records.
+ @param length Length of \c bytes.
+ 
+ @return Decoded video preset.
+ */
++ (CNMVideoPreset *)presetFromBytes:(const uint8_t *)bytes length:(NSUInteger)length;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoFeedSnapshot
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)snapshotWithName:(NSString *)name {
+    
+    return [[self alloc] initWithName:name];
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES)[0];
+        _filePath = [cachesPath stringByAppendingPathComponent:name];
+        _resourceAccessQueue = dispatch_queue_create("com.continuumluxury.continuum.feed.snapshot",
+                                                     DISPATCH_QUEUE_SERIAL);
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Storage
+
+- (NSArray<CNMVideo *> *)loadEntriesWithTotalEntriesCount:(NSUInteger *)count {
+    
+    CFAbsoluteTime loadStartDate = CFAbsoluteTimeGetCurrent();
+    NSData *data = [NSData dataWithContentsOfFile:self.filePath options:NSDataReadingMappedAlways error:nil];
+    const uint8_t *bytes = data.bytes;
+    uint16_t version = 0;
+    if (data.length >= kCNMVideoFeedSnapshotHeaderLength) {
+        
+        memcpy(&version, bytes + sizeof(kCNMVideoFeedSnapshotSignature), sizeof(version));
+        version = CFSwapInt16BigToHost(version);
+    }
+    if (version != kCNMVideoFeedSnapshotVersion ||
+        memcmp(bytes, kCNMVideoFeedSnapshotSignature, sizeof(kCNMVideoFeedSnapshotSignature)) != 0) {
+        
+        return nil;
+    }
+    
+    NSMutableArray<CNMVideo *> *entries = [NSMutableArray new];
+    NSUInteger offset = kCNMVideoFeedSnapshotHeaderLength;
+    CNMVideoFeedSnapshotTag tag;
+    const uint8_t *value = NULL;
+    NSUInteger size = 0;
+    while (CNMVideoFeedSnapshotNextRecord(bytes, data.length, &offset, &tag, &value, &size)) {
+        
+        if (tag == CNMVideoFeedSnapshotTotalCountTag) {
+            
+            if (count) { *count = CNMVideoFeedSnapshotNumber(value, size).unsignedIntegerValue; }
+        }
+        else if (tag == CNMVideoFeedSnapshotEntryTag) {
+            
+            CNMVideo *video = [self.class entryFromBytes:value length:size];
+            if (video) { [entries addObject:video]; }
+        }
+    }
+    self.size = data.length;
+    self.loadDuration = CFAbsoluteTimeGetCurrent() - loadStartDate;
+    
+    return entries;
+}
+
+- (void)storeEntries:(NSArray<CNMVideo *> *)entries totalEntriesCount:(NSUInteger)count {
+    
+    NSMutableArray<NSData *> *records = [NSMutableArray arrayWithCapacity:entries.count];
+    for (CNMVideo *video in entries) { [records addObject:[self.class recordForEntry:video]]; }
+    [self storeEntryRecords:records totalEntriesCount:count];
+}
+
+- (void)storeEntryRecords:(NSArray<NSData *> *)records totalEntriesCount:(NSUInteger)count {
+    
+    uint16_t version = CFSwapInt16HostToBig(kCNMVideoFeedSnapshotVersion);
+    NSMutableData *data = [NSMutableData new];
+    [data appendBytes:kCNMVideoFeedSnapshotSignature length:sizeof(kCNMVideoFeedSnapshotSignature)];
+    [data appendBytes:&version length:sizeof(version)];
+    CNMVideoFeedSnapshotAppendNumber(data, CNMVideoFeedSnapshotTotalCountTag, @(count));
+    for (NSData *record in records) {
+        
+        CNMVideoFeedSnapshotAppendRecord(data, CNMVideoFeedSnapshotEntryTag, record.bytes, record.length);
+    }
+    
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        if ([data writeToFile:self.filePath atomically:YES]) { self.size = data.length; }
+    });
+}
+
+- (void)removeStoredEntries {
+    
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        [[NSFileManager defaultManager] removeItemAtPath:self.filePath error:nil];
+    });
+}
+
+
+#pragma mark - Records
+
++ (NSData *)recordForEntry:(CNMVideo *)video {
+    
+    NSMutableData *data = [NSMutableData new];
+    CNMVideoFeedSnapshotAppendString(data, CNMVideoFeedSnapshotIdentifierTag, video.identifier);
+    CNMVideoFeedSnapshotAppendNumber(data, CNMVideoFeedSnapshotIdxTag, video.idx);
+    CNMVideoFeedSnapshotAppendString(data, CNMVideoFeedSnapshotNameTag, video.name);
+    CNMVideoFeedSnapshotAppendString(data, CNMVideoFeedSnapshotAuthorTag, video.author);
+    CNMVideoFeedSnapshotAppendString(data, CNMVideoFeedSnapshotImagePathTag, video.imagePath);
+    CNMVideoFeedSnapshotAppendString(data, CNMVideoFeedSnapshotCreationDateTag, video.creationDate);
+    for (CNMVideoPreset *preset in video.presets) {
+        
+        NSMutableData *presetData = [NSMutableData new];
+        CNMVideoFeedSnapshotAppendNumber(presetData, CNMVideoFeedSnapshotPresetWidthTag, preset.width);
+        CNMVideoFeedSnapshotAppendNumber(presetData, CNMVideoFeedSnapshotPresetHeightTag, preset.height);
+        CNMVideoFeedSnapshotAppendNumber(presetData, CNMVideoFeedSnapshotPresetSizeTag, preset.size);
+        CNMVideoFeedSnapshotAppendString(presetData, CNMVideoFeedSnapshotPresetURLTag, preset.url);
+        CNMVideoFeedSnapshotAppendNumber(presetData, CNMVideoFeedSnapshotPresetDurationTag, preset.duration);
+        CNMVideoFeedSnapshotAppendString(presetData, CNMVideoFeedSnapshotPresetQualityTag, preset.quality);
+        CNMVideoFeedSnapshotAppendRecord(data, CNMVideoFeedSnapshotPresetTag, presetData.bytes, presetData.length);
+    }
+    
+    return data;
+}
+
++ (CNMVideo *)entryFromRecord:(NSData *)record {
+    
+    return [self entryFromBytes:record.bytes length:record.length];
+}
+
++ (CNMVideo *)entryFromBytes:(const uint8_t *)bytes length:(NSUInteger)length {
+    
+    CNMVideo *video = [CNMVideo new];
+    NSMutableArray<CNMVideoPreset *> *presets = [NSMutableArray new];
+    NSUInteger offset = 0;
+    CNMVideoFeedSnapshotTag tag;
+    const uint8_t *value = NULL;
+    NSUInteger size = 0;
+    while (CNMVideoFeedSnapshotNextRecord(bytes, length, &offset, &tag, &value, &size)) {
+        
+        switch (tag) {
+            case CNMVideoFeedSnapshotIdentifierTag:
+                video.identifier = CNMVideoFeedSnapshotString(value, size);
+                break;
+            case CNMVideoFeedSnapshotIdxTag:
+                video.idx = CNMVideoFeedSnapshotNumber(value, size);
+                break;
+            case CNMVideoFeedSnapshotNameTag:
+                video.name = CNMVideoFeedSnapshotString(value, size);
+                break;
+            case CNMVideoFeedSnapshotAuthorTag:
+                video.author = CNMVideoFeedSnapshotString(value, size);
+                break;
+            case CNMVideoFeedSnapshotImagePathTag:
+                video.imagePath = CNMVideoFeedSnapshotString(value, size);
+                break;
+            case CNMVideoFeedSnapshotCreationDateTag:
+                // Stored in same representation as dictionary mapping does.
+                video.creationDate = (id)CNMVideoFeedSnapshotString(value, size);
+                break;
+            case CNMVideoFeedSnapshotPresetTag:
+                [presets addObject:[self presetFromBytes:value length:size]];
+                break;
+            default:
+                // Record has been added by newer application version.
+                break;
+        }
+    }
+    for (CNMVideoPreset *preset in presets) { preset.video = video.identifier; }
+    video.presets = presets;
+    
+    return (video.identifier.length ? video : nil);
+}
+
++ (CNMVideoPreset *)presetFromBytes:(const uint8_t *)bytes length:(NSUInteger)length {
+    
+    CNMVideoPreset *preset = [CNMVideoPreset new];
+    NSUInteger offset = 0;
+    CNMVideoFeedSnapshotTag tag;
+    const uint8_t *value = NULL;
+    NSUInteger size = 0;
+    while (CNMVideoFeedSnapshotNextRecord(bytes, length, &offset, &tag, &value, &size)) {
+        
+        switch (tag) {
+            case CNMVideoFeedSnapshotPresetWidthTag:
+                preset.width = CNMVideoFeedSnapshotNumber(value, size);
+                break;
+            case CNMVideoFeedSnapshotPresetHeightTag:
+                preset.height = CNMVideoFeedSnapshotNumber(value, size);
+                break;
+            case CNMVideoFeedSnapshotPresetSizeTag:
+                preset.size = CNMVideoFeedSnapshotNumber(value, size);
+                break;
+            case CNMVideoFeedSnapshotPresetURLTag:
+                preset.url = CNMVideoFeedSnapshotString(value, size);
+                break;
+            case CNMVideoFeedSnapshotPresetDurationTag:
+                preset.duration = CNMVideoFeedSnapshotNumber(value, size);
+                break;
+            case CNMVideoFeedSnapshotPresetQualityTag:
+                preset.quality = CNMVideoFeedSnapshotString(value, size);
+                break;
+            default:
+                // Record has been added by newer application version.
+                break;
+        }
+    }
+    
+    return preset;
+}
+
+#pragma mark -
+
+
+@end
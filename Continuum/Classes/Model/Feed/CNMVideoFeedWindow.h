@@ -0,0 +1,111 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMVideo;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Memory-bounded window of video feed entries.
+ @discussion Window keep full entries information only for entries which is close to visible one. Distant
+             entries compacted to stubs which keep only identifier, idx and location of entry record in file
+             on disk. Stubs restored from records as soon as they get close to visible entry or when they
+             should be shown. Each window use own records file which is removed along with window (files left
+             after previous session removed on first window creation). Record written only once for each
+             version of entry, so entries which hasn't been changed since they has been restored reuse it.
+             Window never modify entries: stubs and restored entries is copies which should replace original
+             entries, so lists of entries which has been passed to other queues stay unchanged. Instance is not
+             thread-safe and should be used from queue which own entries.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMVideoFeedWindow : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores approximate number of bytes which can be used by entries which is not close to visible entry.
+ @note   Default value is \c 256 KB.
+ */
+@property (nonatomic, assign) NSUInteger memoryBudget;
+
+/**
+ @brief  Stores number of entries around visible entry which always keep full information.
+ @note   Default value is \c 3.
+ */
+@property (nonatomic, assign) NSUInteger residentRadius;
+
+/**
+ @brief  Stores number of entries which keep full information after last window update.
+ */
+@property (nonatomic, readonly, assign) NSUInteger residentEntriesCount;
+
+/**
+ @brief  Stores number of entries which has been compacted to stubs after last window update.
+ */
+@property (nonatomic, readonly, assign) NSUInteger stubbedEntriesCount;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure feed window which will store compacted entries records in directory with
+         specified name.
+ 
+ @param name Name of directory inside of application's caches directory.
+ 
+ @return Configured and ready to use feed window.
+ */
++ (instancetype)windowWithName:(NSString *)name;
+
+
+///------------------------------------------------
+/// @name Entries
+///------------------------------------------------
+
+/**
+ @brief      Move window to the entry at specified position.
+ @discussion Entries around \c index restored from stubs and most distant entries compacted to stubs while
+             memory budget is exceeded.
+ 
+ @param entries List of all feed entries sorted by \c idx.
+ @param index   Position of visible entry.
+ 
+ @return List of entries in which restored and compacted entries replaced with their copies.
+ */
+- (NSArray<CNMVideo *> *)updateEntries:(NSArray<CNMVideo *> *)entries aroundIndex:(NSUInteger)index;
+
+/**
+ @brief  Restore entry information if it has been compacted to stub.
+ 
+ @param video Reference on video entry which should keep full information.
+ 
+ @return Restored copy of \c video or \c video itself if it isn't stub (or it's record can't be read).
+ */
+- (CNMVideo *)restoredEntry:(CNMVideo *)video;
+
+/**
+ @brief  Retrieve entry record which can be used with feed snapshot.
+ 
+ @param video Reference on video entry (or stub) for which record should be retrieved.
+ 
+ @return Binary representation of video entry records.
+ */
+- (NSData *)recordForEntry:(CNMVideo *)video;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
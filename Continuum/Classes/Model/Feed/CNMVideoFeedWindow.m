@@ -0,0 +1,319 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMVideoFeedWindow.h"
+#import <CommonCrypto/CommonDigest.h>
+#import "CNMVideoFeedSnapshot.h"
+#import "CNMVideoPreset.h"
+#import "CNMVideo+Private.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores default approximate number of bytes which can be used by entries which is not close to visible
+         entry.
+ */
+static NSUInteger const kCNMDefaultMemoryBudget = 256 * 1024;
+
+/**
+ @brief  Stores default number of entries around visible entry which always keep full information.
+ */
+static NSUInteger const kCNMDefaultResidentRadius = 3;
+
+/**
+ @brief  Stores approximate number of bytes which is used by entry and preset instances w/o their strings.
+ */
+static NSUInteger const kCNMEntryBaseSize = 128;
+static NSUInteger const kCNMPresetBaseSize = 96;
+
+
+#pragma mark - Structures
+
+/**
+ @brief  Structure describes location of entry record which has been written to records file.
+ */
+typedef struct CNMVideoFeedWindowRecord {
+    
+    /**
+     @brief  Stores offset of record in records file.
+     */
+    unsigned long long offset;
+    
+    /**
+     @brief  Stores record length.
+     */
+    NSUInteger length;
+    
+    /**
+     @brief  Stores digest of record bytes which is used to find out whether entry has been changed.
+     */
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+} CNMVideoFeedWindowRecord;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMVideoFeedWindow ()
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger residentEntriesCount;
+@property (nonatomic, assign) NSUInteger stubbedEntriesCount;
+
+/**
+ @brief  Stores reference on full path to the file where compacted entries records is stored.
+ */
+@property (nonatomic, copy) NSString *filePath;
+
+/**
+ @brief  Stores reference on handle which is used to append and read compacted entries records.
+ */
+@property (nonatomic) NSFileHandle *fileHandle;
+
+/**
+ @brief  Stores reference on dictionary where each key is entry identifier and value is location of last record
+         which has been written for it (\c CNMVideoFeedWindowRecord).
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSData *> *records;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize feed window which will store compacted entries records in directory with specified name.
+ 
+ @param name Name of directory inside of application's caches directory.
+ 
+ @return Initialized and ready to use feed window.
+ */
+- (instancetype)initWithName:(NSString *)name;
+
+
+#pragma mark - Entries
+
+/**
+ @brief      Store entry record on disk and compact entry to stub.
+ @discussion If entry hasn't been changed since last record has been written for it, record is reused.
+ 
+ @param video Reference on video entry which should be compacted.
+ 
+ @return Stub copy of \c video or \c video itself if records file can't be used.
+ */
+- (CNMVideo *)compactedEntry:(CNMVideo *)video;
+
+/**
+ @brief  Read compacted entry record from disk.
+ 
+ @param video Reference on stub for which record should be read.
+ 
+ @return Binary representation of video entry records.
+ */
+- (NSData *)storedRecordForEntry:(CNMVideo *)video;
+
+
+#pragma mark - Misc
+
+/**
+ @brief      Prepare directory in which windows with same name store their records files.
+ @discussion Records files from previous session removed when directory prepared for the first time.
+ 
+ @param name Name of directory inside of application's caches directory.
+ 
+ @return Full path to the directory.
+ */
++ (NSString *)recordsDirectoryWithName:(NSString *)name;
+
+/**
+ @brief  Calculate approximate number of bytes which is used by entry information.
+ 
+ @param video Reference on video entry for which size should be calculated.
+ 
+ @return Approximate entry size in bytes.
+ */
+- (NSUInteger)estimatedSizeOfEntry:(CNMVideo *)video;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMVideoFeedWindow
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)windowWithName:(NSString *)name {
+    
+    return [[self alloc] initWithName:name];
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        // Each window use own file, so other managers won't truncate records which is used by it's stubs.
+        NSString *directoryPath = [CNMVideoFeedWindow recordsDirectoryWithName:name];
+        _filePath = [directoryPath stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+        _memoryBudget = kCNMDefaultMemoryBudget;
+        _residentRadius = kCNMDefaultResidentRadius;
+        _records = [NSMutableDictionary new];
+        [[NSFileManager defaultManager] createFileAtPath:_filePath contents:nil attributes:nil];
+        _fileHandle = [NSFileHandle fileHandleForUpdatingAtPath:_filePath];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Entries
+
+- (NSArray<CNMVideo *> *)updateEntries:(NSArray<CNMVideo *> *)entries aroundIndex:(NSUInteger)index {
+    
+    NSUInteger count = entries.count;
+    if (count == 0) { return entries; }
+    index = MIN(index, count - 1);
+    
+    // Entries visited from visible one to the most distant, so closest entries use memory budget first.
+    NSMutableArray<CNMVideo *> *updatedEntries = [entries mutableCopy];
+    NSUInteger usedMemory = 0;
+    NSUInteger stubbedEntriesCount = 0;
+    NSUInteger maximumDistance = MAX(index, count - 1 - index);
+    for (NSUInteger distance = 0; distance <= maximumDistance; distance++) {
+        
+        for (NSUInteger side = 0; side < (distance ? 2 : 1); side++) {
+            
+            if ((side == 0 && index + distance >= count) || (side == 1 && distance > index)) { continue; }
+            
+            NSUInteger entryIdx = (side == 0 ? index + distance : index - distance);
+            CNMVideo *video = entries[entryIdx];
+            if (distance <= self.residentRadius) { video = [self restoredEntry:video]; }
+            else if (!video.isStub) {
+                
+                NSUInteger size = [self estimatedSizeOfEntry:video];
+                if (usedMemory + size <= self.memoryBudget) { usedMemory += size; }
+                else { video = [self compactedEntry:video]; }
+            }
+            if (video.isStub) { stubbedEntriesCount++; }
+            updatedEntries[entryIdx] = video;
+        }
+    }
+    self.stubbedEntriesCount = stubbedEntriesCount;
+    self.residentEntriesCount = count - stubbedEntriesCount;
+    
+    return updatedEntries;
+}
+
+- (CNMVideo *)restoredEntry:(CNMVideo *)video {
+    
+    if (video.isStub) {
+        
+        CNMVideo *storedVideo = [CNMVideoFeedSnapshot entryFromRecord:[self storedRecordForEntry:video]];
+        if (storedVideo) {
+            
+            video = [video copy];
+            [video restoreFromVideo:storedVideo];
+        }
+    }
+    
+    return video;
+}
+
+- (NSData *)recordForEntry:(CNMVideo *)video {
+    
+    NSData *record = (video.isStub ? [self storedRecordForEntry:video] : nil);
+    
+    return (record.length ? record : [CNMVideoFeedSnapshot recordForEntry:video]);
+}
+
+- (CNMVideo *)compactedEntry:(CNMVideo *)video {
+    
+    // Entry stay resident if records file can't be opened.
+    if (!self.fileHandle) { return video; }
+    
+    NSData *record = [CNMVideoFeedSnapshot recordForEntry:video];
+    CNMVideoFeedWindowRecord location = {.offset = 0, .length = record.length};
+    CC_SHA1(record.bytes, (CC_LONG)record.length, location.digest);
+    
+    // Unchanged entry has been restored from last record which has been written for it.
+    NSData *storedLocation = self.records[video.identifier];
+    const CNMVideoFeedWindowRecord *lastLocation = storedLocation.bytes;
+    if (lastLocation && lastLocation->length == location.length &&
+        memcmp(lastLocation->digest, location.digest, CC_SHA1_DIGEST_LENGTH) == 0) {
+        
+        location.offset = lastLocation->offset;
+    }
+    else {
+        
+        location.offset = [self.fileHandle seekToEndOfFile];
+        [self.fileHandle writeData:record];
+        self.records[video.identifier] = [NSData dataWithBytes:&location length:sizeof(location)];
+    }
+    
+    CNMVideo *stub = [video copy];
+    [stub compactWithRecordOffset:location.offset length:location.length];
+    
+    return stub;
+}
+
+- (NSData *)storedRecordForEntry:(CNMVideo *)video {
+    
+    [self.fileHandle seekToFileOffset:video.recordOffset];
+    NSData *record = [self.fileHandle readDataOfLength:video.recordLength];
+    
+    return (record.length == video.recordLength ? record : nil);
+}
+
+
+#pragma mark - Misc
+
++ (NSString *)recordsDirectoryWithName:(NSString *)name {
+    
+    static NSMutableSet<NSString *> *_preparedDirectories;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{ _preparedDirectories = [NSMutableSet new]; });
+    
+    NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES)[0];
+    NSString *directoryPath = [cachesPath stringByAppendingPathComponent:name];
+    @synchronized (_preparedDirectories) {
+        
+        // Records from previous session not used by any stubs.
+        if (![_preparedDirectories containsObject:directoryPath]) {
+            
+            NSFileManager *fileManager = [NSFileManager defaultManager];
+            [fileManager removeItemAtPath:directoryPath error:nil];
+            [fileManager createDirectoryAtPath:directoryPath withIntermediateDirectories:YES attributes:nil
+                                         error:nil];
+            [_preparedDirectories addObject:directoryPath];
+        }
+    }
+    
+    return directoryPath;
+}
+
+- (NSUInteger)estimatedSizeOfEntry:(CNMVideo *)video {
+    
+    NSUInteger size = (kCNMEntryBaseSize + video.identifier.length + video.name.length + video.author.length +
+                       video.imagePath.length);
+    for (CNMVideoPreset *preset in video.presets) { size += kCNMPresetBaseSize + preset.url.length; }
+    
+    return size;
+}
+
+- (void)dealloc {
+    
+    [self.fileHandle closeFile];
+    [[NSFileManager defaultManager] removeItemAtPath:self.filePath error:nil];
+}
+
+#pragma mark -
+
+
+@end
@@ -8,7 +8,46 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-#pragma mark Private interface declaration
+#pragma mark Structures
+
+/**
+ @brief  Structure describes video preset representation structure.
+ */
+struct CNMVideoPresetDataStructure {
+    
+    /**
+     @brief  Stores key under which video file width is stored.
+     */
+    __unsafe_unretained NSString *width;
+    
+    /**
+     @brief  Stores key under which video file height is stored.
+     */
+    __unsafe_unretained NSString *height;
+    
+    /**
+     @brief  Stores key under which video file size is stored.
+     */
+    __unsafe_unretained NSString *size;
+    
+    /**
+     @brief  Stores key under which video file URL is stored.
+     */
+    __unsafe_unretained NSString *url;
+    
+    /**
+     @brief  Stores key-path under which video file quality is stored.
+     */
+    __unsafe_unretained NSString *quality;
+};
+
+/**
+ @brief  Stores keys under which data stored in remote data provider response.
+ */
+extern struct CNMVideoPresetDataStructure CNMVideoPresetData;
+
+
+#pragma mark - Private interface declaration
 
 @interface CNMVideoPreset ()
 
@@ -0,0 +1,88 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Incremental JSON tokenizer which allow to decode elements of collection from response body while it
+             is still arriving.
+ @discussion Parser expect what root object is dictionary and track it's members. As soon as element of
+             collection stored under \c collectionKey is complete it is passed to decoder. Other root object
+             members de-serialized when they are complete. Each byte of response scanned only once. In case if
+             response has unexpected layout, whole body will be de-serialized with \b NSJSONSerialization on
+             completion.
+             Instance is not thread-safe and all calls should be done from same serial queue.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMJSONStreamParser : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on response body which has been processed so far.
+ */
+@property (nonatomic, readonly, strong) NSData *data;
+
+/**
+ @brief  Stores how many collection elements has been decoded so far.
+ */
+@property (nonatomic, readonly, assign) NSUInteger decodedElementsCount;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure parser for response which store collection under specified key.
+ 
+ @param key     Name of root object member which store collection which should be streamed.
+ @param decoder Reference on block which is called for each complete collection element with it's binary
+                representation and return object which should be stored in collection instead of it. If
+                decoder return \c nil element will be skipped. If \c nil passed, elements will be
+                de-serialized with \b NSJSONSerialization.
+ 
+ @return Configured and ready to use parser.
+ */
++ (instancetype)parserWithCollectionKey:(NSString *)key
+                         elementDecoder:(nullable id _Nullable (^)(NSData *elementData))decoder;
+
+
+///------------------------------------------------
+/// @name Parsing
+///------------------------------------------------
+
+/**
+ @brief  Process next portion of response body.
+ 
+ @param data Reference on received data chunk.
+ */
+- (void)appendData:(NSData *)data;
+
+/**
+ @brief  Complete response body processing.
+ 
+ @param error Reference on pointer where de-serialization error should be stored.
+ 
+ @return Root object where collection elements replaced with decoded objects.
+ */
+- (nullable id)finishWithError:(NSError *__autoreleasing *)error;
+
+/**
+ @brief      Forget response body which has been received so far.
+ @discussion Should be called before body of repeated request will be passed to the parser.
+ */
+- (void)reset;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
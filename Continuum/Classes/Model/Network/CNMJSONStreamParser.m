@@ -0,0 +1,467 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMJSONStreamParser.h"
+
+
+#pragma mark Types
+
+/**
+ @brief  Root object member processing states.
+ */
+typedef NS_ENUM(NSUInteger, CNMJSONStreamMemberState) {
+    
+    /**
+     @brief  Parser wait for member name.
+     */
+    CNMJSONStreamExpectKey,
+    
+    /**
+     @brief  Parser scan member name.
+     */
+    CNMJSONStreamInKey,
+    
+    /**
+     @brief  Parser wait for name / value separator.
+     */
+    CNMJSONStreamExpectColon,
+    
+    /**
+     @brief  Parser wait for member value.
+     */
+    CNMJSONStreamExpectValue,
+    
+    /**
+     @brief  Parser scan member value.
+     */
+    CNMJSONStreamInValue
+};
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMJSONStreamParser () {
+    
+    /**
+     @brief  Stores offset in \c buffer from which scanning should be continued.
+     */
+    NSUInteger _offset;
+    
+    /**
+     @brief  Stores current containers nesting level (root object has level \c 1).
+     */
+    NSUInteger _depth;
+    
+    /**
+     @brief  Stores whether scanner currently inside of string and whether next character is escaped.
+     */
+    BOOL _inString;
+    BOOL _escaped;
+    
+    /**
+     @brief  Stores whether response has layout which can't be processed incrementally.
+     */
+    BOOL _failed;
+    
+    /**
+     @brief  Stores current root object member processing state.
+     */
+    CNMJSONStreamMemberState _memberState;
+    
+    /**
+     @brief  Stores offsets at which currently processed member name, member value and collection element
+             started.
+     */
+    NSUInteger _keyStart;
+    NSUInteger _valueStart;
+    NSUInteger _elementStart;
+    
+    /**
+     @brief  Stores whether scanner currently inside of streamed collection.
+     */
+    BOOL _inCollection;
+}
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger decodedElementsCount;
+
+/**
+ @brief  Stores reference on name of root object member which store streamed collection.
+ */
+@property (nonatomic, copy) NSString *collectionKey;
+
+/**
+ @brief  Stores reference on block which is used to decode collection elements.
+ */
+@property (nonatomic, copy) id (^elementDecoder)(NSData *elementData);
+
+/**
+ @brief  Stores reference on response body which has been received so far.
+ */
+@property (nonatomic) NSMutableData *buffer;
+
+/**
+ @brief  Stores reference on name of root object member which is processed at this moment.
+ */
+@property (nonatomic, copy) NSString *currentKey;
+
+/**
+ @brief  Stores reference on objects which has been decoded from streamed collection.
+ */
+@property (nonatomic) NSMutableArray *elements;
+
+/**
+ @brief  Stores reference on root object members which has been processed so far.
+ */
+@property (nonatomic) NSMutableDictionary *members;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize parser for response which store collection under specified key.
+ 
+ @param key     Name of root object member which store collection which should be streamed.
+ @param decoder Reference on block which is called for each complete collection element.
+ 
+ @return Initialized and ready to use parser.
+ */
+- (instancetype)initWithCollectionKey:(NSString *)key elementDecoder:(id (^)(NSData *elementData))decoder;
+
+
+#pragma mark - Scanning
+
+/**
+ @brief  Scan bytes which has been appended since last scan.
+ */
+- (void)scan;
+
+/**
+ @brief  Mark passed offset as value start if parser wait for root member value or collection element.
+ 
+ @param offset Offset in \c buffer at which value started.
+ */
+- (void)markValueStartAt:(NSUInteger)offset;
+
+/**
+ @brief  Complete root object member value processing.
+ 
+ @param offset Offset in \c buffer at which value ended.
+ */
+- (void)completeMemberAt:(NSUInteger)offset;
+
+/**
+ @brief  Complete streamed collection element processing.
+ 
+ @param offset Offset in \c buffer at which element ended.
+ */
+- (void)completeElementAt:(NSUInteger)offset;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  De-serialize JSON fragment from specified range of \c buffer.
+ 
+ @param range Range of bytes which store fragment.
+ 
+ @return De-serialized object or \c nil in case of error.
+ */
+- (id)objectInRange:(NSRange)range;
+
+/**
+ @brief      Replace elements of streamed collection in de-serialized root object with decoded objects.
+ @discussion Used when response can't be processed incrementally, so receiver get same objects as it would
+             get from streamed response.
+ 
+ @param object Reference on root object which has been de-serialized as whole.
+ 
+ @return Root object where collection elements replaced with decoded objects.
+ */
+- (id)objectByDecodingCollectionOfObject:(id)object;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMJSONStreamParser
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)parserWithCollectionKey:(NSString *)key elementDecoder:(id (^)(NSData *elementData))decoder {
+    
+    return [[self alloc] initWithCollectionKey:key elementDecoder:decoder];
+}
+
+- (instancetype)initWithCollectionKey:(NSString *)key elementDecoder:(id (^)(NSData *elementData))decoder {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _collectionKey = [key copy];
+        _elementDecoder = [decoder copy];
+        _buffer = [NSMutableData new];
+        _elements = [NSMutableArray new];
+        _members = [NSMutableDictionary new];
+        _elementStart = NSNotFound;
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Information
+
+- (NSData *)data {
+    
+    return self.buffer;
+}
+
+
+#pragma mark - Parsing
+
+- (void)appendData:(NSData *)data {
+    
+    [self.buffer appendData:data];
+    if (!_failed) { [self scan]; }
+}
+
+- (id)finishWithError:(NSError *__autoreleasing *)error {
+    
+    id object = nil;
+    if (!_failed && _depth == 0 && _memberState != CNMJSONStreamExpectKey) {
+        
+        object = [self.members copy];
+    }
+    else if (self.buffer.length) {
+        
+        // Response can't be processed incrementally, so de-serialize it as whole.
+        NSError *deserializationError = nil;
+        object = [NSJSONSerialization JSONObjectWithData:self.buffer options:(NSJSONReadingOptions)0
+                                                   error:&deserializationError];
+        object = [self objectByDecodingCollectionOfObject:object];
+        if (error) { *error = deserializationError; }
+    }
+    
+    return object;
+}
+
+- (void)reset {
+    
+    self.buffer.length = 0;
+    self.currentKey = nil;
+    self.decodedElementsCount = 0;
+    [self.elements removeAllObjects];
+    [self.members removeAllObjects];
+    _offset = 0;
+    _depth = 0;
+    _inString = NO;
+    _escaped = NO;
+    _failed = NO;
+    _memberState = CNMJSONStreamExpectKey;
+    _keyStart = 0;
+    _valueStart = 0;
+    _elementStart = NSNotFound;
+    _inCollection = NO;
+}
+
+
+#pragma mark - Scanning
+
+- (void)scan {
+    
+    const uint8_t *bytes = (const uint8_t *)self.buffer.bytes;
+    NSUInteger length = self.buffer.length;
+    for (NSUInteger offset = _offset; offset < length && !_failed; offset++) {
+        
+        uint8_t character = bytes[offset];
+        if (_inString) {
+            
+            if (_escaped) { _escaped = NO; }
+            else if (character == '\\') { _escaped = YES; }
+            else if (character == '"') {
+                
+                _inString = NO;
+                if (_depth == 1 && _memberState == CNMJSONStreamInKey) {
+                    
+                    self.currentKey = [self objectInRange:NSMakeRange(_keyStart, offset - _keyStart + 1)];
+                    _memberState = CNMJSONStreamExpectColon;
+                    _failed = (self.currentKey == nil);
+                }
+            }
+            continue;
+        }
+        
+        switch (character) {
+            case '"':
+                _inString = YES;
+                if (_depth == 1 && _memberState == CNMJSONStreamExpectKey) {
+                    
+                    _keyStart = offset;
+                    _memberState = CNMJSONStreamInKey;
+                }
+                else { [self markValueStartAt:offset]; }
+                break;
+            case '{':
+            case '[':
+                if (_depth == 0) {
+                    
+                    // Only dictionary as root object can be processed incrementally.
+                    _failed = (character != '{' || _memberState != CNMJSONStreamExpectKey);
+                    _depth = 1;
+                    break;
+                }
+                [self markValueStartAt:offset];
+                _depth++;
+                if (_depth == 2 && character == '[' && [self.currentKey isEqualToString:self.collectionKey]) {
+                    
+                    _inCollection = YES;
+                    _elementStart = NSNotFound;
+                }
+                break;
+            case '}':
+            case ']':
+                if (_depth == 2 && _inCollection) {
+                    
+                    [self completeElementAt:offset];
+                    _inCollection = NO;
+                }
+                if (_depth == 1) {
+                    
+                    if (_memberState == CNMJSONStreamInValue) { [self completeMemberAt:offset]; }
+                    // Mark root object as completed.
+                    _memberState = CNMJSONStreamInValue;
+                }
+                _depth--;
+                break;
+            case ',':
+                if (_depth == 1) {
+                    
+                    [self completeMemberAt:offset];
+                    _memberState = CNMJSONStreamExpectKey;
+                }
+                else if (_depth == 2 && _inCollection) { [self completeElementAt:offset]; }
+                break;
+            case ':':
+                if (_depth == 1 && _memberState == CNMJSONStreamExpectColon) {
+                    
+                    _memberState = CNMJSONStreamExpectValue;
+                }
+                break;
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+            default:
+                [self markValueStartAt:offset];
+                break;
+        }
+    }
+    _offset = length;
+}
+
+- (void)markValueStartAt:(NSUInteger)offset {
+    
+    if (_depth == 1 && _memberState == CNMJSONStreamExpectValue) {
+        
+        _valueStart = offset;
+        _memberState = CNMJSONStreamInValue;
+    }
+    else if (_depth == 2 && _inCollection && _elementStart == NSNotFound) { _elementStart = offset; }
+}
+
+- (void)completeMemberAt:(NSUInteger)offset {
+    
+    if (_memberState != CNMJSONStreamInValue) {
+        
+        _failed = YES;
+        return;
+    }
+    
+    BOOL isCollection = (((const uint8_t *)self.buffer.bytes)[_valueStart] == '[');
+    if (isCollection && [self.currentKey isEqualToString:self.collectionKey]) {
+        
+        self.members[self.currentKey] = [self.elements copy];
+    }
+    else {
+        
+        id value = [self objectInRange:NSMakeRange(_valueStart, offset - _valueStart)];
+        if (value) { self.members[self.currentKey] = value; }
+        else { _failed = YES; }
+    }
+    self.currentKey = nil;
+}
+
+- (void)completeElementAt:(NSUInteger)offset {
+    
+    if (_elementStart == NSNotFound) { return; }
+    
+    NSData *elementData = [self.buffer subdataWithRange:NSMakeRange(_elementStart, offset - _elementStart)];
+    id element = nil;
+    if (self.elementDecoder) { element = self.elementDecoder(elementData); }
+    else {
+        
+        element = [NSJSONSerialization JSONObjectWithData:elementData options:NSJSONReadingAllowFragments
+                                                    error:nil];
+    }
+    
+    if (element) {
+        
+        [self.elements addObject:element];
+        self.decodedElementsCount++;
+    }
+    _elementStart = NSNotFound;
+}
+
+
+#pragma mark - Misc
+
+- (id)objectInRange:(NSRange)range {
+    
+    NSData *data = [self.buffer subdataWithRange:range];
+    
+    return [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingAllowFragments error:nil];
+}
+
+- (id)objectByDecodingCollectionOfObject:(id)object {
+    
+    NSArray *collection = ([object isKindOfClass:NSDictionary.class] ? object[self.collectionKey] : nil);
+    if (!self.elementDecoder || ![collection isKindOfClass:NSArray.class]) { return object; }
+    
+    // Elements passed to decoder in binary representation, same as while response is streamed.
+    NSMutableArray *elements = [NSMutableArray arrayWithCapacity:collection.count];
+    for (id element in collection) {
+        
+        NSData *elementData = nil;
+        if ([NSJSONSerialization isValidJSONObject:element]) {
+            
+            NSJSONWritingOptions options = (NSJSONWritingOptions)0;
+            elementData = [NSJSONSerialization dataWithJSONObject:element options:options error:nil];
+        }
+        id decodedElement = (elementData ? self.elementDecoder(elementData) : nil);
+        if (decodedElement) {
+            
+            [elements addObject:decodedElement];
+            self.decodedElementsCount++;
+        }
+    }
+    NSMutableDictionary *decodedObject = [object mutableCopy];
+    decodedObject[self.collectionKey] = elements;
+    
+    return [decodedObject copy];
+}
+
+#pragma mark -
+
+
+@end
@@ -1,16 +1,21 @@
 #import <Foundation/Foundation.h>
+#import "CNMBaseRequest.h"
 
 
 #pragma mark Class forward
 
-@class CNMBaseRequest;
+@class CNMResponseCache, CNMNetworkWorkerPool, CNMRequestScheduler, CNMRequestResiliencePolicy, CNMNetworkMetrics;
+@class CNMNetworkTransport;
 
 
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- @brief  Manager which provide ability to perform network requests to pull out JSON data from remote data 
-         proviers.
+ @brief      Manager which provide ability to perform network requests to pull out JSON data from remote data
+             proviers.
+ @discussion Manager is lightweight client of shared transport: all managers send requests over same
+             connections and process responses on same workers, but each manager add own headers to requests
+             and can cancel only requests which has been passed to it.
  
  @author Sergey Mamontov
  @since 1.0
@@ -19,12 +24,85 @@ NS_ASSUME_NONNULL_BEGIN
 @interface CNMNetorkManager : NSObject
 
 
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on transport which is used to send requests and process responses.
+ */
+@property (nonatomic, readonly, strong) CNMNetworkTransport *transport;
+
+/**
+ @brief      Stores reference on headers which should be added to each request sent by manager.
+ @discussion Headers override headers with same name which has been provided by request model (for example
+             to use client's own authorization).
+ */
+@property (nonatomic, nullable, copy) NSDictionary<NSString *, NSString *> *HTTPHeaders;
+
+/**
+ @brief  Stores reference on cache which is used to store and revalidate responses for cacheable requests.
+ */
+@property (nonatomic, readonly, strong) CNMResponseCache *responseCache;
+
+/**
+ @brief      Stores reference on pool of workers which process received data.
+ @discussion Pool provide depth and wait time of each lane. While pool is saturated, tasks which process
+             responses in background lane suspended till pool will be drained.
+ */
+@property (nonatomic, readonly, strong) CNMNetworkWorkerPool *workerPool;
+
+/**
+ @brief      Stores reference on scheduler which decide when requests can be sent basing on their priority.
+ @discussion Scheduler provide time which requests of each priority spent in queue and on the wire.
+ */
+@property (nonatomic, readonly, strong) CNMRequestScheduler *scheduler;
+
+/**
+ @brief      Stores reference on policy which decide when failed requests should be repeated and when slow
+             requests should be duplicated.
+ @discussion Policy provide how many requests has been repeated and duplicated, so it is possible to check
+             whether tail latency improvement doesn't cost too much load on remote data provider.
+ */
+@property (nonatomic, readonly, strong) CNMRequestResiliencePolicy *resiliencePolicy;
+
+/**
+ @brief      Stores reference on measurements of requests which has been done by shared transport.
+ @discussion Each request record time spent in scheduler queue, before first byte, on transfer, in wait for
+             worker, on decoding and on delivery to callback queue and also response body size on the wire and
+             after decompression.
+ */
+@property (nonatomic, readonly, strong) CNMNetworkMetrics *metrics;
+
+/**
+ @brief  Stores maximum number of requests which can be performed to same remote data provider at once.
+ */
+@property (nonatomic, readonly, assign) NSUInteger maximumConcurrentRequests;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief      Create manager which send requests over specified transport.
+ @discussion Managers which has been created with \c -init send requests over shared transport.
+ 
+ @param transport Reference on transport which should be used to send requests and process responses.
+ 
+ @return Configured and ready to use network manager.
+ */
++ (instancetype)managerWithTransport:(CNMNetworkTransport *)transport;
+
+
 ///------------------------------------------------
 /// @name Requests
 ///------------------------------------------------
 
 /**
- @brief  Perform network request using model which describe remote resource url.
+ @brief      Perform network request using model which describe remote resource url.
+ @discussion If there is in-flight request for same remote resource, \c request will be attached to it and
+             receive same processing results.
  
  @param request Reference on model which describe remote resource.
  @param block   Reference on block which will be called on main queue and pass two arguments: 
@@ -37,12 +115,72 @@ NS_ASSUME_NONNULL_BEGIN
            completionBlock:(void(^)(id JSONObject, NSError * _Nullable error))block;
 
 /**
- @brief  Stop remote data request.
+ @brief      Perform network request using model which describe remote resource url and decode streamed
+             collection elements while response is still arriving.
+ @discussion If \c request describe response with streamed collection, each collection element passed to
+             \c decoder as soon as it has been received and decoded objects replace elements in \c JSONObject.
+             Decoder called on background queue. If \c request attached to in-flight request for same remote
+             resource, it will receive objects which has been decoded with decoder of that request.
+ 
+ @param request Reference on model which describe remote resource.
+ @param decoder Reference on block which receive binary representation of collection element and return object
+                which should be stored in collection instead of it. If \c nil passed, elements will be parsed
+                with \b NSJSONSerialization.
+ @param block   Reference on block which will be called on main queue and pass two arguments:
+                \c JSONObject - reference on parsed JSON object; \c error - reference on error which describe
+                request issues.
+ 
+ @return Currently active request instance.
+ */
+- (id)fetchJSONWithRequest:(CNMBaseRequest *)request
+            elementDecoder:(nullable id _Nullable (^)(NSData *elementData))decoder
+           completionBlock:(void(^)(id JSONObject, NSError * _Nullable error))block;
+
+/**
+ @brief      Perform network request and call completion block on specified queue.
+ @discussion Allow to process response on background queue w/o hop to main queue and back.
+ 
+ @param request Reference on model which describe remote resource.
+ @param decoder Reference on block which receive binary representation of collection element and return object
+                which should be stored in collection instead of it. If \c nil passed, elements will be parsed
+                with \b NSJSONSerialization.
+ @param queue   Reference on queue on which \c block should be called. If \c nil passed, block will be called
+                on main queue.
+ @param block   Reference on block which pass two arguments: \c JSONObject - reference on parsed JSON object;
+                \c error - reference on error which describe request issues.
+ 
+ @return Currently active request instance.
+ */
+- (id)fetchJSONWithRequest:(CNMBaseRequest *)request
+            elementDecoder:(nullable id _Nullable (^)(NSData *elementData))decoder
+             callbackQueue:(nullable dispatch_queue_t)queue
+           completionBlock:(void(^)(id JSONObject, NSError * _Nullable error))block;
+
+/**
+ @brief      Change priority of request which already has been passed to the manager.
+ @discussion If request still wait for free slot, it may be started before other requests. If request already
+             has been started, it's session task priority will be updated.
+ 
+ @param priority New request priority.
+ @param request  Reference on request instance for which priority should be changed.
+ */
+- (void)updatePriority:(CNMRequestPriority)priority forRequest:(CNMBaseRequest *)request;
+
+/**
+ @brief      Stop remote data request.
+ @discussion Network task will be stopped only when there is no other requests which wait for it. Completion
+             block which has been passed with \c request will be called with \c nil arguments on queue which
+             has been passed along with it.
  
  @param request Reference on request instance which has required information about data request.
  */
 - (void)cancelRequest:(CNMBaseRequest *)request;
 
+/**
+ @brief  Stop all remote data requests which has been passed to the manager and still wait for response.
+ */
+- (void)cancelAllRequests;
+
 #pragma mark -
 
 
@@ -4,92 +4,51 @@
  @copyright © 2015 Continuum LLC.
  */
 #import "CNMNetorkManager.h"
-#import "CNMBaseRequest+Private.h"
-#import <libkern/OSAtomic.h>
+#import "CNMNetworkTransport.h"
 
 
 #pragma mark Private interface declaration
 
-@interface CNMNetorkManager () <NSURLSessionDelegate>
+@interface CNMNetorkManager ()
 
 
 #pragma mark - Properties
 
-/**
- @brief  Stores reference on queue which should be used for
-         data processing.
- */
-@property (nonatomic) dispatch_queue_t parsingQueue;
+@property (nonatomic, strong) CNMNetworkTransport *transport;
 
 /**
- @brief  Stores reference on session instance which is used to 
-         send network requests.
+ @brief  Stores reference on serial queue which is used to access list of requests passed to the manager.
  */
-@property (nonatomic) NSURLSession *session;
+@property (nonatomic) dispatch_queue_t requestsQueue;
 
 /**
- @brief  Stores reference on lock which is used in critical data
-         access sections.
+ @brief  Stores reference on requests which has been passed to the manager and still wait for response.
  */
-@property (nonatomic, assign) OSSpinLock lock;
+@property (nonatomic) NSMutableSet<CNMBaseRequest *> *requests;
 
 
-#pragma mark - Handlers
+#pragma mark - Initialization and Configuration
 
 /**
- @brief  Handle data task request completion.
+ @brief  Initialize manager instance.
  
- @param task         Reference on task which has been used by URL session.
- @param data         Response binary object.
- @param response     HTTP response with all required HTTP fields.
- @param requestError Reference on request processing error.
- @param block        Reference on block which will be called on main queue to notify about requests processing
-                     results.
+ @param transport Reference on transport which should be used to send requests and process responses.
+ 
+ @return Initialized and ready to use network manager.
  */
-- (void)handleDataTaskResponseFor:(NSURLSessionDataTask *)task withData:(NSData *)data
-                         response:(NSHTTPURLResponse *)response error:(NSError *)requestError 
-                  completionBlock:(void (^)(id JSONObject, NSError *error))block;
+- (instancetype)initWithTransport:(CNMNetworkTransport *)transport;
 
 
 #pragma mark - Misc
 
 /**
- @brief  Configure URL session instance for further usage with requests.
- */
-- (void)prepareURLSession;
-
-/**
- @brief  Network request session configuration.
- 
- @return Configured and ready to use session configuration instance.
- */
-- (NSURLSessionConfiguration *)sessionConfiguration;
-
-/**
- @brief  Requests operation queue (queue on which requests performed).
- 
- @param Reference on session configuration instance.
- 
- @return Configured and ready to use operations queue.
- */
-- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration;
-
-/**
- @brief  Initialize network session instance using user-provied configuration.
- 
- @param configuration Reference on session configuration instance.
+ @brief  Compose URL request which should be sent for request model.
  
- @return Configured session for network request session.
- */
-- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration;
-
-/**
- @brief  Extract data received from remote data provider.
+ @param request Reference on model which describe remote resource.
  
- @param data                 Reference on data retrieved from remote data provider.
- @param deserializationError Reference on pointer where de-serialization error should be stored.
+ @return URL request with manager's headers.
  */
-- (id)deserializedResponseFromData:(NSData *)data withError:(NSError *__autoreleasing *)deserializationError;
+- (NSURLRequest *)URLRequestForRequest:(CNMBaseRequest *)request;
 
 #pragma mark -
 
@@ -104,128 +63,135 @@
 
 #pragma mark - Initialization and Configuration
 
++ (instancetype)managerWithTransport:(CNMNetworkTransport *)transport {
+    
+    return [[self alloc] initWithTransport:transport];
+}
+
 - (instancetype)init {
     
+    return [self initWithTransport:[CNMNetworkTransport sharedTransport]];
+}
+
+- (instancetype)initWithTransport:(CNMNetworkTransport *)transport {
+    
     // Check whether initialization was successful or not.
     if ((self = [super init])) {
         
-        _parsingQueue = dispatch_queue_create("com.continuumluxury.continuum.network", DISPATCH_QUEUE_CONCURRENT);
-        _lock = OS_SPINLOCK_INIT;
-        [self prepareURLSession];
+        _transport = transport;
+        _requestsQueue = dispatch_queue_create("com.continuumluxury.continuum.network.requests",
+                                               DISPATCH_QUEUE_SERIAL);
+        _requests = [NSMutableSet new];
     }
     
     return self;
 }
 
-#pragma mark - Requests
 
-- (id)fetchJSONWithRequest:(CNMBaseRequest *)request 
-           completionBlock:(void(^)(id JSONObject, NSError *error))block {
-    
-    __block NSURLSessionDataTask *task = nil;
-    __weak __typeof(self) weakSelf = self;
-    
-    OSSpinLockLock(&_lock);
-    task = [self.session dataTaskWithRequest:request.request 
-                           completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
-        
-        [weakSelf handleDataTaskResponseFor:task withData:data response:(NSHTTPURLResponse *)response
-                                      error:(error?: task.error) completionBlock:block];
-    }];
-    OSSpinLockUnlock(&_lock);
-    request.activeTask = task;
-    [task resume];
+#pragma mark - Information
+
+- (CNMResponseCache *)responseCache {
     
-    return request;
+    return self.transport.responseCache;
 }
 
-- (void)cancelRequest:(CNMBaseRequest *)request {
+- (CNMNetworkWorkerPool *)workerPool {
     
-    OSSpinLockLock(&_lock);
-    [request.activeTask cancel];
-    request.activeTask = nil;
-    OSSpinLockUnlock(&_lock);
+    return self.transport.workerPool;
 }
 
+- (CNMRequestScheduler *)scheduler {
+    
+    return self.transport.scheduler;
+}
 
-#pragma mark - Handlers
-
-- (void)handleDataTaskResponseFor:(NSURLSessionDataTask *)task withData:(NSData *)data
-                         response:(NSHTTPURLResponse *)response error:(NSError *)requestError 
-                  completionBlock:(void (^)(id JSONObject, NSError *error))block {
+- (CNMRequestResiliencePolicy *)resiliencePolicy {
     
-    dispatch_async(self.parsingQueue, ^{
+    return self.transport.resiliencePolicy;
+}
 
-        NSError *serializationError = nil;
-        id processedObject = [self deserializedResponseFromData:data withError:&serializationError];
-        NSError *error = ((requestError.code == NSURLErrorCancelled ? nil : requestError)?: serializationError);
-        dispatch_async(dispatch_get_main_queue(), ^{ block(processedObject, error); });
-    });
+- (CNMNetworkMetrics *)metrics {
+    
+    return self.transport.metrics;
 }
 
-- (void)URLSession:(NSURLSession *)session didBecomeInvalidWithError:(NSError *)error {
+- (NSUInteger)maximumConcurrentRequests {
     
-    if (error) {
-        
-        OSSpinLockLock(&_lock);
-        [self prepareURLSession];
-        OSSpinLockUnlock(&_lock);
-    }
+    return self.transport.maximumConcurrentRequests;
 }
 
 
-#pragma mark - Misc
+#pragma mark - Requests
 
-- (void)prepareURLSession {
+- (id)fetchJSONWithRequest:(CNMBaseRequest *)request
+           completionBlock:(void(^)(id JSONObject, NSError *error))block {
     
-    _session = [self sessionWithConfiguration:[self sessionConfiguration]];
+    return [self fetchJSONWithRequest:request elementDecoder:nil completionBlock:block];
 }
 
-- (NSURLSessionConfiguration *)sessionConfiguration {
-    
-    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
-    configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
-    configuration.URLCache = nil;
-    configuration.HTTPShouldUsePipelining = YES;
-    configuration.timeoutIntervalForRequest = 10.0f;
-    configuration.HTTPMaximumConnectionsPerHost = 5;
-    configuration.HTTPAdditionalHeaders = @{@"Accept-Encoding": @"gzip,deflate", @"Connection": @"keep-alive"};
+- (id)fetchJSONWithRequest:(CNMBaseRequest *)request elementDecoder:(id(^)(NSData *elementData))decoder
+           completionBlock:(void(^)(id JSONObject, NSError *error))block {
     
-    return configuration;
+    return [self fetchJSONWithRequest:request elementDecoder:decoder callbackQueue:nil completionBlock:block];
 }
 
-- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration {
+- (id)fetchJSONWithRequest:(CNMBaseRequest *)request elementDecoder:(id(^)(NSData *elementData))decoder
+             callbackQueue:(dispatch_queue_t)queue completionBlock:(void(^)(id JSONObject, NSError *error))block {
     
-    NSOperationQueue *queue = [NSOperationQueue new];
-    queue.maxConcurrentOperationCount = configuration.HTTPMaximumConnectionsPerHost;
+    dispatch_sync(self.requestsQueue, ^{ [self.requests addObject:request]; });
     
-    return queue;
+    // Request leave manager's cancellation scope as soon as results delivered (or it has been cancelled).
+    __weak __typeof__(self) weakSelf = self;
+    [self.transport fetchJSONWithRequest:request URLRequest:[self URLRequestForRequest:request]
+                          elementDecoder:decoder callbackQueue:(queue ?: dispatch_get_main_queue())
+                         completionBlock:^(id JSONObject, NSError *error) {
+        
+        __strong __typeof__(self) strongSelf = weakSelf;
+        if (strongSelf) {
+            
+            dispatch_async(strongSelf.requestsQueue, ^{ [strongSelf.requests removeObject:request]; });
+        }
+        block(JSONObject, error);
+    }];
+    
+    return request;
 }
 
-- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration {
+- (void)updatePriority:(CNMRequestPriority)priority forRequest:(CNMBaseRequest *)request {
     
-    NSOperationQueue *queue = [self operationQueueWithConfiguration:configuration];
+    [self.transport updatePriority:priority forRequest:request];
+}
+
+- (void)cancelRequest:(CNMBaseRequest *)request {
     
-    return [NSURLSession sessionWithConfiguration:configuration delegate:self
-                                    delegateQueue:queue];
+    [self.transport cancelRequest:request];
 }
 
-- (id)deserializedResponseFromData:(NSData *)data withError:(NSError *__autoreleasing *)deserializationError {
+- (void)cancelAllRequests {
     
-    id deserializedResponse = nil;
-    if ([data length]) {
-        
-        @autoreleasepool {
+    __block NSArray<CNMBaseRequest *> *requests = nil;
+    dispatch_sync(self.requestsQueue, ^{ requests = self.requests.allObjects; });
+    for (CNMBaseRequest *request in requests) { [self.transport cancelRequest:request]; }
+}
+
+
+#pragma mark - Misc
+
+- (NSURLRequest *)URLRequestForRequest:(CNMBaseRequest *)request {
+    
+    NSURLRequest *URLRequest = request.request;
+    NSDictionary<NSString *, NSString *> *headers = self.HTTPHeaders;
+    if (headers.count) {
+    
+        NSMutableURLRequest *clientRequest = [URLRequest mutableCopy];
+        [headers enumerateKeysAndObjectsUsingBlock:^(NSString *field, NSString *value, BOOL *fieldsEnumeratorStop) {
             
-            NSError *JSONDeserializationError = nil;
-            deserializedResponse = [NSJSONSerialization JSONObjectWithData:data
-                                                                   options:(NSJSONReadingOptions)0
-                                                                     error:&JSONDeserializationError];
-            *deserializationError = JSONDeserializationError;
-        }
+            [clientRequest setValue:value forHTTPHeaderField:field];
+        }];
+        URLRequest = clientRequest;
     }
-    
-    return deserializedResponse;
+
+    return URLRequest;
 }
 
 #pragma mark -
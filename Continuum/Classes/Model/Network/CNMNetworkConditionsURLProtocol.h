@@ -0,0 +1,69 @@
+#import <Foundation/Foundation.h>
+
+
+#if DEBUG
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Network conditions simulator which stand between network manager and remote data provider.
+ @discussion Protocol pass requests to remote data provider (or to \c CNMReplayURLProtocol stand-in if it is
+             enabled) and deliver responses under conditions described by scenario: latency distribution,
+             bandwidth cap, connection resets, partial bodies, timeouts, captive portal pages and bursts of
+             server errors. Conditions can be configured for each endpoint separately.
+             Scenario is JSON file with following structure:
+             @code
+{
+  "name": "Poor 3G",
+  "default": {"latency": {"median": 400, "p95": 1500}, "bandwidth": 40},
+  "endpoints": [
+    {"path": "^/channels/[^/]+/videos", "reset": 0.02, "partial": 0.05, "timeout": 0.01,
+     "serverErrors": {"rate": 0.05, "burst": 3, "status": 503}},
+    {"path": "^/videos/", "latency": {"min": 100, "max": 3000}, "portal": 0.01}
+  ]
+}
+             @endcode
+             \c latency is set in milliseconds as fixed value, \c min / \c max (uniform distribution) or
+             \c median / \c p95 (log-normal distribution), \c bandwidth in KB/s. Faults are set as probability
+             of fault for each request. \c path is regular expression which is matched against request path
+             (first matched endpoint override \c default conditions).
+             Protocol used by network manager's session only (not registered globally) and should be configured
+             before network manager creation. Available only in debug builds and can be enabled with
+             \c -CNMNetworkScenario \c <path> launch argument.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMNetworkConditionsURLProtocol : NSURLProtocol
+
+
+///------------------------------------------------
+/// @name Configuration
+///------------------------------------------------
+
+/**
+ @brief  Retrieve whether simulator has been configured with scenario.
+ 
+ @return \c YES in case if requests pass through simulator.
+ */
++ (BOOL)isEnabled;
+
+/**
+ @brief  Load scenario which should be used to simulate network conditions.
+ 
+ @param path  Full path to the file with scenario description.
+ @param error Pointer into which scenario loading error will be stored.
+ 
+ @return \c YES in case if scenario has been loaded.
+ */
++ (BOOL)loadScenarioFromFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif // DEBUG
@@ -0,0 +1,673 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMNetworkConditionsURLProtocol.h"
+#if DEBUG
+#import "CNMReplayURLProtocol.h"
+
+
+#pragma mark Types and Structures
+
+/**
+ @brief  Faults which can be simulated for request.
+ */
+typedef NS_ENUM(NSUInteger, CNMNetworkFault) {
+    
+    /**
+     @brief  Response delivered under configured latency and bandwidth.
+     */
+    CNMNoNetworkFault,
+    
+    /**
+     @brief  Connection lost before response has been received.
+     */
+    CNMConnectionResetNetworkFault,
+    
+    /**
+     @brief  Connection lost while response body has been received.
+     */
+    CNMPartialBodyNetworkFault,
+    
+    /**
+     @brief  Response never arrive and request time out.
+     */
+    CNMTimeoutNetworkFault,
+    
+    /**
+     @brief  Server respond with error status code (can be repeated for few requests in a row).
+     */
+    CNMServerErrorNetworkFault,
+    
+    /**
+     @brief  Captive portal respond with HTML page instead of requested resource.
+     */
+    CNMCaptivePortalNetworkFault
+};
+
+
+#pragma mark - Static
+
+/**
+ @brief  Stores interval (in seconds) between response body chunks delivery.
+ */
+static NSTimeInterval const kCNMConditionsChunkInterval = 0.05f;
+
+/**
+ @brief  Stores reference on conditions which is used for requests which doesn't match any endpoint.
+ */
+static NSDictionary *CNMConditionsDefaults;
+
+/**
+ @brief  Stores reference on list of endpoints (path expression and conditions) described by scenario.
+ */
+static NSArray<NSDictionary *> *CNMConditionsEndpoints;
+
+/**
+ @brief  Stores reference on number of server errors which still should be returned for endpoint.
+ */
+static NSMutableDictionary<NSString *, NSNumber *> *CNMConditionsServerErrorBursts;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMNetworkConditionsURLProtocol ()
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on thread on which protocol has been started (client should be notified on it).
+ */
+@property (nonatomic) NSThread *clientThread;
+
+/**
+ @brief  Stores reference on run loop mode in which protocol has been started.
+ */
+@property (nonatomic, copy) NSString *runLoopMode;
+
+/**
+ @brief  Stores when protocol has been started.
+ */
+@property (nonatomic, assign) CFAbsoluteTime startDate;
+
+/**
+ @brief  Stores time (in seconds) after which response should be received.
+ */
+@property (nonatomic, assign) NSTimeInterval latency;
+
+/**
+ @brief  Stores number of bytes which can be delivered per second (\c 0 for unlimited).
+ */
+@property (nonatomic, assign) NSUInteger bandwidth;
+
+/**
+ @brief  Stores which fault has been chosen for request.
+ */
+@property (nonatomic, assign) CNMNetworkFault fault;
+
+/**
+ @brief  Stores reference on task which fetch response from remote data provider.
+ */
+@property (nonatomic, nullable) NSURLSessionDataTask *upstreamTask;
+
+/**
+ @brief  Stores reference on response which should be delivered to the client after latency.
+ */
+@property (nonatomic, nullable) NSHTTPURLResponse *response;
+
+/**
+ @brief  Stores reference on response body which is delivered to the client.
+ */
+@property (nonatomic) NSData *body;
+
+/**
+ @brief  Stores number of body bytes which should be delivered before connection will be closed.
+ */
+@property (nonatomic, assign) NSUInteger deliverableBytesCount;
+
+/**
+ @brief  Stores number of body bytes which already has been delivered to the client.
+ */
+@property (nonatomic, assign) NSUInteger deliveredBytesCount;
+
+/**
+ @brief  Stores reference on timer which deliver response body chunks.
+ */
+@property (nonatomic, nullable) NSTimer *deliveryTimer;
+
+
+#pragma mark - Scenario
+
+/**
+ @brief  Retrieve reference on queue which is used to access scenario and server errors bursts.
+ 
+ @return Serial queue.
+ */
++ (dispatch_queue_t)scenarioQueue;
+
+/**
+ @brief  Find conditions under which request should be processed.
+ 
+ @param request Reference on request for which conditions should be found.
+ 
+ @return Conditions of matched endpoint or default conditions.
+ */
++ (NSDictionary *)conditionsForRequest:(NSURLRequest *)request;
+
+/**
+ @brief  Choose fault which should be simulated for request.
+ 
+ @param conditions Reference on conditions under which request should be processed.
+ 
+ @return One of \c CNMNetworkFault fields.
+ */
++ (CNMNetworkFault)faultForConditions:(NSDictionary *)conditions;
+
+/**
+ @brief  Sample response latency from conditions latency distribution.
+ 
+ @param conditions Reference on conditions under which request should be processed.
+ 
+ @return Latency in seconds.
+ */
++ (NSTimeInterval)latencyForConditions:(NSDictionary *)conditions;
+
+
+#pragma mark - Upstream
+
+/**
+ @brief  Retrieve reference on session which is used to fetch responses from remote data provider.
+ 
+ @return Shared session.
+ */
++ (NSURLSession *)upstreamSession;
+
+/**
+ @brief  Fetch response from remote data provider.
+ */
+- (void)fetchUpstream;
+
+/**
+ @brief  Handle remote data provider response.
+ 
+ @param response Reference on received response.
+ @param data     Reference on received response body.
+ @param error    Reference on request processing error.
+ */
+- (void)handleUpstreamResponse:(nullable NSHTTPURLResponse *)response withData:(nullable NSData *)data
+                         error:(nullable NSError *)error;
+
+
+#pragma mark - Delivery
+
+/**
+ @brief  Schedule response delivery to the client after remaining latency.
+ 
+ @param response Reference on response which should be delivered.
+ @param body     Reference on response body which should be delivered.
+ */
+- (void)startDeliveryOfResponse:(NSHTTPURLResponse *)response withBody:(NSData *)body;
+
+/**
+ @brief  Deliver response (if not delivered yet) and next body chunk which fit into bandwidth.
+ */
+- (void)deliverNextChunk;
+
+/**
+ @brief  Schedule request failure.
+ 
+ @param code  \c NSURLErrorDomain error code with which request should fail.
+ @param delay Time (in seconds) after which request should fail.
+ */
+- (void)failWithErrorCode:(NSInteger)code afterDelay:(NSTimeInterval)delay;
+
+/**
+ @brief  Notify client what request did fail.
+ 
+ @param error Reference on request processing error.
+ */
+- (void)failWithError:(NSError *)error;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Create response which is returned by simulator itself.
+ 
+ @param statusCode  HTTP status code.
+ @param contentType Response body MIME type.
+ @param body        Reference on response body.
+ 
+ @return Configured response.
+ */
+- (NSHTTPURLResponse *)responseWithStatusCode:(NSInteger)statusCode contentType:(NSString *)contentType
+                                         body:(NSData *)body;
+
+/**
+ @brief  Calculate how much time is left till response should be received.
+ 
+ @return Remaining latency in seconds.
+ */
+- (NSTimeInterval)remainingLatency;
+
+/**
+ @brief  Call block on thread on which protocol has been started.
+ 
+ @param block Reference on block which should be called.
+ */
+- (void)performOnClientThread:(dispatch_block_t)block;
+
+/**
+ @brief  Call passed block.
+ 
+ @param block Reference on block which should be called.
+ */
+- (void)performBlock:(dispatch_block_t)block;
+
+/**
+ @brief  Retrieve random value from \c [0, 1] range.
+ 
+ @return Random value.
+ */
++ (double)randomValue;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMNetworkConditionsURLProtocol
+
+
+#pragma mark - Configuration
+
++ (BOOL)isEnabled {
+    
+    __block BOOL enabled = NO;
+    dispatch_sync([self scenarioQueue], ^{ enabled = (CNMConditionsDefaults != nil); });
+    
+    return enabled;
+}
+
++ (BOOL)loadScenarioFromFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    
+    NSData *data = [NSData dataWithContentsOfFile:path options:0 error:error];
+    NSDictionary *scenario = (data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:error] : nil);
+    if (![scenario isKindOfClass:[NSDictionary class]]) {
+        
+        if (scenario && error) {
+            
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError
+                                     userInfo:@{NSFilePathErrorKey: path}];
+        }
+        
+        return NO;
+    }
+    
+    NSDictionary *defaults = scenario[@"default"];
+    defaults = ([defaults isKindOfClass:[NSDictionary class]] ? defaults : @{});
+    NSMutableArray<NSDictionary *> *endpoints = [NSMutableArray new];
+    for (NSDictionary *endpoint in scenario[@"endpoints"]) {
+        
+        NSString *pattern = (endpoint[@"path"] ?: @"");
+        NSRegularExpression *expression = [NSRegularExpression regularExpressionWithPattern:pattern options:0
+                                                                                      error:error];
+        if (!expression) { return NO; }
+        
+        NSMutableDictionary *conditions = [defaults mutableCopy];
+        [conditions addEntriesFromDictionary:endpoint];
+        [endpoints addObject:@{@"expression": expression, @"conditions": conditions}];
+    }
+    
+    dispatch_sync([self scenarioQueue], ^{
+        
+        CNMConditionsDefaults = defaults;
+        CNMConditionsEndpoints = endpoints;
+        CNMConditionsServerErrorBursts = [NSMutableDictionary new];
+    });
+    NSLog(@"<Continuum::Conditions> Simulating '%@' scenario (%lu endpoints)", (scenario[@"name"] ?: path),
+          (unsigned long)endpoints.count);
+    
+    return YES;
+}
+
+
+#pragma mark - Protocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    
+    return [self isEnabled];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    
+    return request;
+}
+
+- (void)startLoading {
+    
+    self.clientThread = [NSThread currentThread];
+    self.runLoopMode = ([NSRunLoop currentRunLoop].currentMode ?: NSDefaultRunLoopMode);
+    self.startDate = CFAbsoluteTimeGetCurrent();
+    NSDictionary *conditions = [[self class] conditionsForRequest:self.request];
+    self.latency = [[self class] latencyForConditions:conditions];
+    self.bandwidth = (NSUInteger)MAX([conditions[@"bandwidth"] doubleValue], 0.0f) * 1024;
+    self.fault = [[self class] faultForConditions:conditions];
+    if (self.fault != CNMNoNetworkFault) {
+        
+        NSLog(@"<Continuum::Conditions> Fault %lu for %@", (unsigned long)self.fault, self.request.URL.path);
+    }
+    
+    if (self.fault == CNMConnectionResetNetworkFault) {
+        
+        [self failWithErrorCode:NSURLErrorNetworkConnectionLost afterDelay:self.latency];
+    }
+    else if (self.fault == CNMTimeoutNetworkFault) {
+        
+        // Session's own request timeout most likely will fire earlier.
+        [self failWithErrorCode:NSURLErrorTimedOut afterDelay:self.request.timeoutInterval];
+    }
+    else if (self.fault == CNMServerErrorNetworkFault) {
+        
+        NSInteger statusCode = ([conditions[@"serverErrors"][@"status"] integerValue] ?: 503);
+        NSData *body = [NSData data];
+        NSHTTPURLResponse *response = [self responseWithStatusCode:statusCode contentType:@"application/json"
+                                                              body:body];
+        [self startDeliveryOfResponse:response withBody:body];
+    }
+    else if (self.fault == CNMCaptivePortalNetworkFault) {
+        
+        NSData *body = [@"<html><head><title>Sign in</title></head><body>Wi-Fi login</body></html>"
+                        dataUsingEncoding:NSUTF8StringEncoding];
+        NSHTTPURLResponse *response = [self responseWithStatusCode:200 contentType:@"text/html" body:body];
+        [self startDeliveryOfResponse:response withBody:body];
+    }
+    else { [self fetchUpstream]; }
+}
+
+- (void)stopLoading {
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self.upstreamTask cancel];
+    [self.deliveryTimer invalidate];
+    self.deliveryTimer = nil;
+}
+
+
+#pragma mark - Scenario
+
++ (dispatch_queue_t)scenarioQueue {
+    
+    static dispatch_queue_t _scenarioQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        _scenarioQueue = dispatch_queue_create("com.continuumluxury.continuum.conditions", DISPATCH_QUEUE_SERIAL);
+    });
+    
+    return _scenarioQueue;
+}
+
++ (NSDictionary *)conditionsForRequest:(NSURLRequest *)request {
+    
+    NSString *path = (request.URL.path ?: @"");
+    __block NSDictionary *conditions = nil;
+    dispatch_sync([self scenarioQueue], ^{
+        
+        conditions = CNMConditionsDefaults;
+        for (NSDictionary *endpoint in CNMConditionsEndpoints) {
+            
+            NSRegularExpression *expression = endpoint[@"expression"];
+            if ([expression firstMatchInString:path options:0 range:NSMakeRange(0, path.length)]) {
+                
+                conditions = endpoint[@"conditions"];
+                break;
+            }
+        }
+    });
+    
+    return (conditions ?: @{});
+}
+
++ (CNMNetworkFault)faultForConditions:(NSDictionary *)conditions {
+    
+    NSString *endpoint = (conditions[@"path"] ?: @"default");
+    NSDictionary *serverErrors = conditions[@"serverErrors"];
+    __block CNMNetworkFault fault = CNMNoNetworkFault;
+    dispatch_sync([self scenarioQueue], ^{
+        
+        // Server which already started to fail keep failing for whole burst.
+        NSUInteger burstLeft = CNMConditionsServerErrorBursts[endpoint].unsignedIntegerValue;
+        if (burstLeft > 0) {
+            
+            CNMConditionsServerErrorBursts[endpoint] = @(burstLeft - 1);
+            fault = CNMServerErrorNetworkFault;
+            return;
+        }
+        
+        double value = [self randomValue];
+        double threshold = 0.0f;
+        NSArray<NSNumber *> *faults = @[@(CNMConnectionResetNetworkFault), @(CNMTimeoutNetworkFault),
+                                        @(CNMPartialBodyNetworkFault), @(CNMCaptivePortalNetworkFault),
+                                        @(CNMServerErrorNetworkFault)];
+        NSArray<NSNumber *> *rates = @[@([conditions[@"reset"] doubleValue]),
+                                       @([conditions[@"timeout"] doubleValue]),
+                                       @([conditions[@"partial"] doubleValue]),
+                                       @([conditions[@"portal"] doubleValue]),
+                                       @([serverErrors[@"rate"] doubleValue])];
+        for (NSUInteger faultIdx = 0; faultIdx < faults.count; faultIdx++) {
+            
+            threshold += rates[faultIdx].doubleValue;
+            if (value < threshold) {
+                
+                fault = (CNMNetworkFault)faults[faultIdx].unsignedIntegerValue;
+                break;
+            }
+        }
+        
+        if (fault == CNMServerErrorNetworkFault) {
+            
+            NSUInteger burst = MAX([serverErrors[@"burst"] unsignedIntegerValue], 1);
+            CNMConditionsServerErrorBursts[endpoint] = @(burst - 1);
+        }
+    });
+    
+    return fault;
+}
+
++ (NSTimeInterval)latencyForConditions:(NSDictionary *)conditions {
+    
+    id latency = conditions[@"latency"];
+    double milliseconds = 0.0f;
+    if ([latency isKindOfClass:[NSNumber class]]) { milliseconds = [latency doubleValue]; }
+    else if ([latency isKindOfClass:[NSDictionary class]] && latency[@"median"]) {
+        
+        // Log-normal distribution which pass through median and 95th percentile.
+        double median = [latency[@"median"] doubleValue];
+        double p95 = MAX([latency[@"p95"] doubleValue], median);
+        double sigma = (median > 0.0f ? log(p95 / median) / 1.645f : 0.0f);
+        double normal = sqrt(-2.0f * log(MAX([self randomValue], DBL_MIN))) * cos(2.0f * M_PI * [self randomValue]);
+        milliseconds = median * exp(sigma * normal);
+    }
+    else if ([latency isKindOfClass:[NSDictionary class]]) {
+        
+        double minimum = [latency[@"min"] doubleValue];
+        double maximum = MAX([latency[@"max"] doubleValue], minimum);
+        milliseconds = minimum + (maximum - minimum) * [self randomValue];
+    }
+    
+    return MAX(milliseconds, 0.0f) / 1000.0f;
+}
+
+
+#pragma mark - Upstream
+
++ (NSURLSession *)upstreamSession {
+    
+    static NSURLSession *_upstreamSession;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        configuration.URLCache = nil;
+        configuration.HTTPMaximumConnectionsPerHost = 5;
+        if ([CNMReplayURLProtocol isEnabled]) {
+            
+            configuration.protocolClasses = [@[CNMReplayURLProtocol.class]
+                                             arrayByAddingObjectsFromArray:configuration.protocolClasses];
+        }
+        _upstreamSession = [NSURLSession sessionWithConfiguration:configuration];
+    });
+    
+    return _upstreamSession;
+}
+
+- (void)fetchUpstream {
+    
+    __weak __typeof__(self) weakSelf = self;
+    self.upstreamTask = [[[self class] upstreamSession] dataTaskWithRequest:self.request
+                                                          completionHandler:^(NSData *data, NSURLResponse *response,
+                                                                              NSError *error) {
+        
+        __strong __typeof__(self) strongSelf = weakSelf;
+        [strongSelf performOnClientThread:^{
+            
+            [strongSelf handleUpstreamResponse:(NSHTTPURLResponse *)response withData:data error:error];
+        }];
+    }];
+    [self.upstreamTask resume];
+}
+
+- (void)handleUpstreamResponse:(NSHTTPURLResponse *)response withData:(NSData *)data error:(NSError *)error {
+    
+    if (error) {
+        
+        if (error.code != NSURLErrorCancelled) {
+            
+            [self performSelector:@selector(failWithError:) withObject:error afterDelay:[self remainingLatency]
+                          inModes:@[self.runLoopMode]];
+        }
+        
+        return;
+    }
+    
+    // Body already has been decompressed, so headers should describe it as it is.
+    NSMutableDictionary *headers = [response.allHeaderFields mutableCopy];
+    [headers removeObjectForKey:@"Content-Encoding"];
+    headers[@"Content-Length"] = [NSString stringWithFormat:@"%lu", (unsigned long)data.length];
+    NSHTTPURLResponse *deliveredResponse = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                                       statusCode:response.statusCode
+                                                                      HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    [self startDeliveryOfResponse:deliveredResponse withBody:(data ?: [NSData data])];
+}
+
+
+#pragma mark - Delivery
+
+- (void)startDeliveryOfResponse:(NSHTTPURLResponse *)response withBody:(NSData *)body {
+    
+    self.response = response;
+    self.body = body;
+    self.deliverableBytesCount = body.length;
+    if (self.fault == CNMPartialBodyNetworkFault) {
+        
+        self.deliverableBytesCount = (NSUInteger)(body.length * (0.1f + 0.8f * [[self class] randomValue]));
+    }
+    
+    NSDate *fireDate = [NSDate dateWithTimeIntervalSinceNow:[self remainingLatency]];
+    self.deliveryTimer = [[NSTimer alloc] initWithFireDate:fireDate interval:kCNMConditionsChunkInterval target:self
+                                                  selector:@selector(deliverNextChunk) userInfo:nil repeats:YES];
+    [[NSRunLoop currentRunLoop] addTimer:self.deliveryTimer forMode:self.runLoopMode];
+}
+
+- (void)deliverNextChunk {
+    
+    if (self.response) {
+        
+        [self.client URLProtocol:self didReceiveResponse:self.response
+              cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+        self.response = nil;
+    }
+    
+    NSUInteger length = (self.deliverableBytesCount - self.deliveredBytesCount);
+    if (self.bandwidth > 0) {
+        
+        length = MIN(length, MAX((NSUInteger)(self.bandwidth * kCNMConditionsChunkInterval), 1));
+    }
+    if (length) {
+        
+        NSData *chunk = [self.body subdataWithRange:NSMakeRange(self.deliveredBytesCount, length)];
+        self.deliveredBytesCount += length;
+        [self.client URLProtocol:self didLoadData:chunk];
+    }
+    
+    if (self.deliveredBytesCount == self.deliverableBytesCount) {
+        
+        [self.deliveryTimer invalidate];
+        self.deliveryTimer = nil;
+        if (self.deliverableBytesCount < self.body.length) {
+            
+            [self failWithErrorCode:NSURLErrorNetworkConnectionLost afterDelay:0.0f];
+        }
+        else { [self.client URLProtocolDidFinishLoading:self]; }
+    }
+}
+
+- (void)failWithErrorCode:(NSInteger)code afterDelay:(NSTimeInterval)delay {
+    
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:code
+                                     userInfo:@{NSURLErrorFailingURLErrorKey: self.request.URL}];
+    [self performSelector:@selector(failWithError:) withObject:error afterDelay:delay inModes:@[self.runLoopMode]];
+}
+
+- (void)failWithError:(NSError *)error {
+    
+    [self.client URLProtocol:self didFailWithError:error];
+}
+
+
+#pragma mark - Misc
+
+- (NSHTTPURLResponse *)responseWithStatusCode:(NSInteger)statusCode contentType:(NSString *)contentType
+                                         body:(NSData *)body {
+    
+    NSString *length = [NSString stringWithFormat:@"%lu", (unsigned long)body.length];
+    NSDictionary *headers = @{@"Content-Type": contentType, @"Content-Length": length};
+    
+    return [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1"
+                                     headerFields:headers];
+}
+
+- (NSTimeInterval)remainingLatency {
+    
+    return MAX(self.latency - (CFAbsoluteTimeGetCurrent() - self.startDate), 0.0f);
+}
+
+- (void)performOnClientThread:(dispatch_block_t)block {
+    
+    [self performSelector:@selector(performBlock:) onThread:self.clientThread withObject:[block copy]
+            waitUntilDone:NO modes:@[self.runLoopMode]];
+}
+
+- (void)performBlock:(dispatch_block_t)block {
+    
+    block();
+}
+
++ (double)randomValue {
+    
+    return ((double)arc4random() / UINT32_MAX);
+}
+
+#pragma mark -
+
+
+@end
+
+#endif // DEBUG
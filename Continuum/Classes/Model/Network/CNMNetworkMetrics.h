@@ -0,0 +1,179 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMNetworkMetricsHistogram;
+
+
+#pragma mark - Types and Structures
+
+/**
+ @brief  Represent enumerator with measurements which is collected for each request.
+ */
+typedef NS_ENUM(NSUInteger, CNMNetworkMetric) {
+    
+    /**
+     @brief  Time (in milliseconds) which request waited for free scheduler slot.
+     */
+    CNMNetworkQueuedTimeMetric,
+    
+    /**
+     @brief  Time (in milliseconds) between session task start and response receive (include DNS lookup,
+             connection and TLS handshake).
+     */
+    CNMNetworkFirstByteTimeMetric,
+    
+    /**
+     @brief  Time (in milliseconds) between response receive and session task completion.
+     */
+    CNMNetworkTransferTimeMetric,
+    
+    /**
+     @brief  Time (in milliseconds) which completed response waited for free worker.
+     */
+    CNMNetworkDecodeWaitTimeMetric,
+    
+    /**
+     @brief  Time (in milliseconds) which has been spent to complete response decoding.
+     */
+    CNMNetworkDecodeTimeMetric,
+    
+    /**
+     @brief  Time (in milliseconds) which processing results waited for callback queue (main by default).
+     */
+    CNMNetworkDeliveryTimeMetric,
+    
+    /**
+     @brief  Number of response body bytes which has been received on the wire (\c Content-Length of compressed
+             response or number of decompressed bytes if response doesn't have it).
+     */
+    CNMNetworkCompressedBytesMetric,
+    
+    /**
+     @brief  Number of response body bytes after decompression.
+     */
+    CNMNetworkDecompressedBytesMetric,
+    
+    /**
+     @brief  \c 1 if request most likely has been sent over warm connection which has been opened for one of
+             previous requests to the same host and \c 0 if connection had to be opened (mean is reuse ratio).
+     */
+    CNMNetworkWarmConnectionMetric,
+    
+    /**
+     @brief  Time (in milliseconds) which first request to the host saved because connection has been
+             pre-warmed (difference between pre-warm and first request time to first byte).
+     */
+    CNMNetworkPrewarmSavedTimeMetric
+};
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Aggregated network requests measurements.
+ @discussion Measurements grouped by endpoint (name of request class) and stored in histogram for each metric,
+             so they can be compared between endpoints and application builds. Metrics can be queried in
+             process or written to JSON file (in debug builds file written when application enter background if
+             it has been started with \c -CNMDumpNetworkMetrics \c YES launch argument).
+             Instance is thread-safe.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMNetworkMetrics : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on list of endpoints for which measurements has been recorded.
+ */
+@property (nonatomic, readonly, copy) NSArray<NSString *> *endpoints;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Retrieve metrics which is shared by all network managers.
+ 
+ @return Configured and ready to use metrics.
+ */
++ (instancetype)sharedMetrics;
+
+/**
+ @brief  Create metrics which isn't shared with network managers.
+ 
+ @return Configured and ready to use metrics.
+ */
++ (instancetype)metrics;
+
+
+///------------------------------------------------
+/// @name Measurements
+///------------------------------------------------
+
+/**
+ @brief  Store measured time.
+ 
+ @param interval Measured time in seconds (stored in milliseconds).
+ @param metric   One of time metrics.
+ @param endpoint Name of endpoint for which time has been measured.
+ */
+- (void)recordInterval:(NSTimeInterval)interval forMetric:(CNMNetworkMetric)metric ofEndpoint:(NSString *)endpoint;
+
+/**
+ @brief  Store measured value.
+ 
+ @param value    Measured value.
+ @param metric   Metric for which value has been measured.
+ @param endpoint Name of endpoint for which value has been measured.
+ */
+- (void)recordValue:(double)value forMetric:(CNMNetworkMetric)metric ofEndpoint:(NSString *)endpoint;
+
+/**
+ @brief  Retrieve measurements of specified metric.
+ 
+ @param metric   Metric for which measurements should be retrieved.
+ @param endpoint Name of endpoint for which measurements should be retrieved.
+ 
+ @return Copy of histogram or \c nil in case if there is no measurements for \c endpoint.
+ */
+- (nullable CNMNetworkMetricsHistogram *)histogramForMetric:(CNMNetworkMetric)metric
+                                                 ofEndpoint:(NSString *)endpoint;
+
+/**
+ @brief  Compose dictionary where each key is endpoint name and value is dictionary with histograms of each
+         metric.
+ 
+ @return Dictionary representation which can be serialized to JSON.
+ */
+- (NSDictionary<NSString *, id> *)dictionaryRepresentation;
+
+/**
+ @brief  Write measurements to the file in JSON format.
+ 
+ @param path  Full path to the file which should be written.
+ @param error Reference on pointer where write error should be stored.
+ 
+ @return \c YES in case if file has been written.
+ */
+- (BOOL)writeToFile:(NSString *)path error:(NSError *__autoreleasing *)error;
+
+/**
+ @brief  Remove all measurements.
+ */
+- (void)reset;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
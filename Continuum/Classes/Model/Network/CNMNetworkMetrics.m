@@ -0,0 +1,190 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMNetworkMetrics.h"
+#import "CNMNetworkMetricsHistogram.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores number of metrics which is collected for each endpoint.
+ */
+static NSUInteger const kCNMNetworkMetricsCount = (CNMNetworkPrewarmSavedTimeMetric + 1);
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMNetworkMetrics ()
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on dictionary where each key is endpoint name and value is list of histograms (in
+         same order as metrics declared).
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSArray<CNMNetworkMetricsHistogram *> *> *histograms;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to histograms.
+ */
+@property (nonatomic) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Retrieve name which is used for metric in dictionary representation.
+ 
+ @param metric Metric for which name should be retrieved.
+ 
+ @return Metric name.
+ */
+- (NSString *)nameOfMetric:(CNMNetworkMetric)metric;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMNetworkMetrics
+
+
+#pragma mark - Information
+
+- (NSArray<NSString *> *)endpoints {
+    
+    __block NSArray<NSString *> *endpoints = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{ endpoints = self.histograms.allKeys; });
+    
+    return endpoints;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)sharedMetrics {
+    
+    static CNMNetworkMetrics *_sharedMetrics;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{ _sharedMetrics = [self new]; });
+    
+    return _sharedMetrics;
+}
+
++ (instancetype)metrics {
+    
+    return [self new];
+}
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _histograms = [NSMutableDictionary new];
+        _resourceAccessQueue = dispatch_queue_create("com.continuumluxury.continuum.network.metrics",
+                                                     DISPATCH_QUEUE_SERIAL);
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Measurements
+
+- (void)recordInterval:(NSTimeInterval)interval forMetric:(CNMNetworkMetric)metric ofEndpoint:(NSString *)endpoint {
+    
+    [self recordValue:(interval * 1000.0f) forMetric:metric ofEndpoint:endpoint];
+}
+
+- (void)recordValue:(double)value forMetric:(CNMNetworkMetric)metric ofEndpoint:(NSString *)endpoint {
+    
+    // Measurements recorded from network processing queues which shouldn't wait for histograms.
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        NSArray<CNMNetworkMetricsHistogram *> *histograms = self.histograms[endpoint];
+        if (!histograms) {
+            
+            NSMutableArray *endpointHistograms = [NSMutableArray arrayWithCapacity:kCNMNetworkMetricsCount];
+            for (NSUInteger metricIdx = 0; metricIdx < kCNMNetworkMetricsCount; metricIdx++) {
+                
+                [endpointHistograms addObject:[CNMNetworkMetricsHistogram histogram]];
+            }
+            histograms = [endpointHistograms copy];
+            self.histograms[endpoint] = histograms;
+        }
+        [histograms[metric] recordValue:value];
+    });
+}
+
+- (CNMNetworkMetricsHistogram *)histogramForMetric:(CNMNetworkMetric)metric ofEndpoint:(NSString *)endpoint {
+    
+    __block CNMNetworkMetricsHistogram *histogram = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{ histogram = [self.histograms[endpoint][metric] copy]; });
+    
+    return histogram;
+}
+
+- (NSDictionary<NSString *, id> *)dictionaryRepresentation {
+    
+    NSMutableDictionary<NSString *, id> *representation = [NSMutableDictionary new];
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        [self.histograms enumerateKeysAndObjectsUsingBlock:^(NSString *endpoint,
+                                                             NSArray<CNMNetworkMetricsHistogram *> *histograms,
+                                                             BOOL *histogramsEnumeratorStop) {
+            
+            NSMutableDictionary<NSString *, id> *metrics = [NSMutableDictionary new];
+            [histograms enumerateObjectsUsingBlock:^(CNMNetworkMetricsHistogram *histogram, NSUInteger metricIdx,
+                                                     BOOL *metricsEnumeratorStop) {
+                
+                metrics[[self nameOfMetric:metricIdx]] = [histogram dictionaryRepresentation];
+            }];
+            representation[endpoint] = metrics;
+        }];
+    });
+    
+    return representation;
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError *__autoreleasing *)error {
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[self dictionaryRepresentation]
+                                                   options:NSJSONWritingPrettyPrinted error:error];
+    
+    return (data && [data writeToFile:path options:NSDataWritingAtomic error:error]);
+}
+
+- (void)reset {
+    
+    dispatch_async(self.resourceAccessQueue, ^{ [self.histograms removeAllObjects]; });
+}
+
+
+#pragma mark - Misc
+
+- (NSString *)nameOfMetric:(CNMNetworkMetric)metric {
+    
+    static NSArray<NSString *> *_metricNames;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        _metricNames = @[@"queued_ms", @"first_byte_ms", @"transfer_ms", @"decode_wait_ms", @"decode_ms",
+                         @"delivery_ms", @"compressed_bytes", @"decompressed_bytes", @"warm_connection",
+                         @"prewarm_saved_ms"];
+    });
+    
+    return _metricNames[metric];
+}
+
+#pragma mark -
+
+
+@end
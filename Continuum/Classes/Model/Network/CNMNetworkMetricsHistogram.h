@@ -0,0 +1,89 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Histogram of measured values with logarithmic buckets.
+ @discussion Each power of two split into four buckets, so percentiles reported with less than 19% error
+             while histogram use fixed amount of memory for any number of measurements.
+             Instance is not thread-safe.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMNetworkMetricsHistogram : NSObject <NSCopying>
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores number of recorded values.
+ */
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+/**
+ @brief  Stores sum of recorded values.
+ */
+@property (nonatomic, readonly, assign) double sum;
+
+/**
+ @brief  Stores smallest recorded value.
+ */
+@property (nonatomic, readonly, assign) double minimum;
+
+/**
+ @brief  Stores biggest recorded value.
+ */
+@property (nonatomic, readonly, assign) double maximum;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure empty histogram.
+ 
+ @return Configured and ready to use histogram.
+ */
++ (instancetype)histogram;
+
+
+///------------------------------------------------
+/// @name Measurements
+///------------------------------------------------
+
+/**
+ @brief  Store measured value in corresponding bucket.
+ 
+ @param value Measured value (negative values stored as \c 0).
+ */
+- (void)recordValue:(double)value;
+
+/**
+ @brief  Retrieve value below which specified part of recorded values is.
+ 
+ @param percentile Part of recorded values (from \c 0 to \c 1).
+ 
+ @return Upper bound of bucket which contain requested percentile or \c 0 in case if there is no values.
+ */
+- (double)valueAtPercentile:(double)percentile;
+
+/**
+ @brief  Compose dictionary with summary (count, sum, minimum, maximum, mean and percentiles) and non-empty
+         buckets which can be serialized to JSON.
+ 
+ @return Dictionary representation of histogram.
+ */
+- (NSDictionary<NSString *, id> *)dictionaryRepresentation;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,157 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMNetworkMetricsHistogram.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores number of buckets into which each power of two is split.
+ */
+static NSUInteger const kCNMBucketsPerPowerOfTwo = 4;
+
+/**
+ @brief  Stores number of buckets in histogram (first bucket store values smaller than \c 1).
+ */
+static NSUInteger const kCNMBucketsCount = 129;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMNetworkMetricsHistogram () {
+    
+    /**
+     @brief  Stores number of values which has been stored in each bucket.
+     */
+    NSUInteger _counts[kCNMBucketsCount];
+}
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) double sum;
+@property (nonatomic, assign) double minimum;
+@property (nonatomic, assign) double maximum;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Find bucket in which value should be stored.
+ 
+ @param value Measured value.
+ 
+ @return Bucket index.
+ */
+- (NSUInteger)bucketForValue:(double)value;
+
+/**
+ @brief  Calculate biggest value which can be stored in bucket.
+ 
+ @param bucket Bucket index.
+ 
+ @return Bucket upper bound.
+ */
+- (double)upperBoundOfBucket:(NSUInteger)bucket;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMNetworkMetricsHistogram
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)histogram {
+    
+    return [self new];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    CNMNetworkMetricsHistogram *histogram = [[self class] new];
+    histogram.count = self.count;
+    histogram.sum = self.sum;
+    histogram.minimum = self.minimum;
+    histogram.maximum = self.maximum;
+    memcpy(histogram->_counts, _counts, sizeof(_counts));
+    
+    return histogram;
+}
+
+
+#pragma mark - Measurements
+
+- (void)recordValue:(double)value {
+    
+    value = MAX(value, 0.0f);
+    _counts[[self bucketForValue:value]]++;
+    self.minimum = (self.count ? MIN(self.minimum, value) : value);
+    self.maximum = (self.count ? MAX(self.maximum, value) : value);
+    self.sum += value;
+    self.count++;
+}
+
+- (double)valueAtPercentile:(double)percentile {
+    
+    if (!self.count) { return 0.0f; }
+    
+    NSUInteger targetCount = MAX((NSUInteger)ceil(self.count * MIN(MAX(percentile, 0.0f), 1.0f)), 1);
+    NSUInteger count = 0;
+    for (NSUInteger bucket = 0; bucket < kCNMBucketsCount; bucket++) {
+        
+        count += _counts[bucket];
+        if (count >= targetCount) { return MIN([self upperBoundOfBucket:bucket], self.maximum); }
+    }
+    
+    return self.maximum;
+}
+
+- (NSDictionary<NSString *, id> *)dictionaryRepresentation {
+    
+    NSMutableDictionary<NSString *, NSNumber *> *buckets = [NSMutableDictionary new];
+    for (NSUInteger bucket = 0; bucket < kCNMBucketsCount; bucket++) {
+        
+        if (_counts[bucket]) {
+            
+            NSString *upperBound = [NSString stringWithFormat:@"%.2f", [self upperBoundOfBucket:bucket]];
+            buckets[upperBound] = @(_counts[bucket]);
+        }
+    }
+    
+    return @{@"count": @(self.count), @"sum": @(self.sum), @"min": @(self.minimum), @"max": @(self.maximum),
+             @"mean": @(self.count ? self.sum / self.count : 0.0f), @"p50": @([self valueAtPercentile:0.5f]),
+             @"p90": @([self valueAtPercentile:0.9f]), @"p95": @([self valueAtPercentile:0.95f]),
+             @"p99": @([self valueAtPercentile:0.99f]), @"buckets": buckets};
+}
+
+
+#pragma mark - Misc
+
+- (NSUInteger)bucketForValue:(double)value {
+    
+    if (value < 1.0f) { return 0; }
+    
+    NSUInteger bucket = (NSUInteger)floor(log2(value) * kCNMBucketsPerPowerOfTwo) + 1;
+    
+    return MIN(bucket, kCNMBucketsCount - 1);
+}
+
+- (double)upperBoundOfBucket:(NSUInteger)bucket {
+    
+    return pow(2.0f, (double)bucket / kCNMBucketsPerPowerOfTwo);
+}
+
+#pragma mark -
+
+
+@end
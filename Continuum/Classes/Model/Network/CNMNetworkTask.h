@@ -0,0 +1,187 @@
+#import <Foundation/Foundation.h>
+#import "CNMBaseRequest.h"
+
+
+#pragma mark Class forward
+
+@class CNMJSONStreamParser;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Model which represent single in-flight network task shared by all requests which point to the same
+             remote resource.
+ @discussion Instance is not thread-safe and should be accessed only from network manager's registry queue.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMNetworkTask : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on canonical remote resource identifier for which task has been created.
+ */
+@property (nonatomic, readonly, copy) NSString *identifier;
+
+/**
+ @brief  Stores reference on request which should be used to create \c dataTask.
+ */
+@property (nonatomic, copy) NSURLRequest *URLRequest;
+
+/**
+ @brief      Stores reference on session data task which is used to pull out remote resource data.
+ @discussion Data task created only when scheduler allow task to start.
+ */
+@property (nonatomic, nullable, strong) NSURLSessionDataTask *dataTask;
+
+/**
+ @brief      Stores reference on duplicate session task which has been started because response for
+             \c dataTask didn't arrive in usual time.
+ @discussion Session task which receive response first become \c dataTask and other one is cancelled.
+ */
+@property (nonatomic, nullable, strong) NSURLSessionDataTask *hedgeDataTask;
+
+/**
+ @brief  Stores reference on name of request class for which task has been created (used to group response
+         time measurements).
+ */
+@property (nonatomic, copy) NSString *requestType;
+
+/**
+ @brief  Stores whether task's responses should be stored and revalidated with conditional requests.
+ */
+@property (nonatomic, assign) BOOL usesResponseCache;
+
+/**
+ @brief  Stores in which worker pool lane task's data is processed.
+ */
+@property (nonatomic, assign) CNMRequestLane lane;
+
+/**
+ @brief  Stores priority of most important request which wait for task completion.
+ */
+@property (nonatomic, readonly, assign) CNMRequestPriority priority;
+
+/**
+ @brief  Stores how many times task can be repeated (biggest budget among requests which wait for task).
+ */
+@property (nonatomic, readonly, assign) NSUInteger maximumRetriesCount;
+
+/**
+ @brief  Stores how many times task already has been repeated.
+ */
+@property (nonatomic, assign) NSUInteger retriesCount;
+
+/**
+ @brief  Stores whether at least one request which wait for task allow to send duplicate session task.
+ */
+@property (nonatomic, readonly, assign, getter = isHedgeable) BOOL hedgeable;
+
+/**
+ @brief  Stores when task has been passed to the scheduler.
+ */
+@property (nonatomic, assign) CFAbsoluteTime scheduleDate;
+
+/**
+ @brief  Stores when task's \c dataTask has been started (\c 0 while task wait for free slot).
+ */
+@property (nonatomic, assign) CFAbsoluteTime startDate;
+
+/**
+ @brief  Stores when response has been received for \c dataTask (\c 0 while it wait for response).
+ */
+@property (nonatomic, assign) CFAbsoluteTime responseDate;
+
+/**
+ @brief  Stores reference on serial queue on which received data should be processed.
+ */
+@property (nonatomic, readonly, strong) dispatch_queue_t processingQueue;
+
+/**
+ @brief      Stores reference on HTTP response which has been received for \c dataTask.
+ @discussion Should be accessed only from \c processingQueue.
+ */
+@property (nonatomic, nullable, strong) NSHTTPURLResponse *response;
+
+/**
+ @brief      Stores reference on response body which has been received so far.
+ @discussion Should be accessed only from \c processingQueue.
+ */
+@property (nonatomic, readonly, strong) NSMutableData *receivedData;
+
+/**
+ @brief      Stores number of response body bytes which has been received so far (after decompression).
+ @discussion Should be accessed only from \c processingQueue.
+ */
+@property (nonatomic, assign) NSUInteger receivedBytesCount;
+
+/**
+ @brief      Stores reference on parser which decode response body while it is arriving (if response has
+             streamed collection).
+ @discussion Should be accessed only from \c processingQueue.
+ */
+@property (nonatomic, nullable, strong) CNMJSONStreamParser *parser;
+
+/**
+ @brief  Stores whether there is at least one request which wait for task completion.
+ */
+@property (nonatomic, readonly, assign) BOOL hasWaiters;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure shared task model.
+ 
+ @param identifier  Canonical remote resource identifier.
+ @param targetQueue Reference on queue on which task's processing queue should perform blocks.
+ 
+ @return Configured and ready to use shared task model.
+ */
++ (instancetype)taskWithIdentifier:(NSString *)identifier processingQueue:(dispatch_queue_t)targetQueue;
+
+
+///------------------------------------------------
+/// @name Waiters
+///------------------------------------------------
+
+/**
+ @brief  Attach request to the task, so it will be notified about processing results.
+ 
+ @param request Reference on request which should wait for task completion.
+ @param block   Reference on block which should be called at the end of task processing.
+ */
+- (void)addWaiter:(CNMBaseRequest *)request withBlock:(void(^)(id JSONObject, NSError * _Nullable error))block;
+
+/**
+ @brief  Detach request from the task, so it won't be notified about processing results.
+ 
+ @param request Reference on request which doesn't wait for task completion anymore.
+ 
+ @return Reference on block which has been passed along with \c request or \c nil in case if \c request
+         wasn't attached to the task.
+ */
+- (nullable void(^)(id JSONObject, NSError * _Nullable error))removeWaiter:(CNMBaseRequest *)request;
+
+/**
+ @brief  Detach all requests from the task.
+ 
+ @return List of blocks which has been passed along with requests.
+ */
+- (NSArray<void(^)(id JSONObject, NSError * _Nullable error)> *)removeAllWaiters;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,137 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMNetworkTask.h"
+#import "CNMBaseRequest+Private.h"
+
+
+#pragma mark Private interface declaration
+
+@interface CNMNetworkTask ()
+
+
+#pragma mark - Properties
+
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, strong) dispatch_queue_t processingQueue;
+@property (nonatomic, strong) NSMutableData *receivedData;
+
+/**
+ @brief  Stores reference on map where each key is request which wait for task completion and value is
+         completion block which has been passed along with it.
+ */
+@property (nonatomic) NSMapTable<CNMBaseRequest *, id> *waiters;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize shared task model.
+ 
+ @param identifier  Canonical remote resource identifier.
+ @param targetQueue Reference on queue on which task's processing queue should perform blocks.
+ 
+ @return Initialized and ready to use shared task model.
+ */
+- (instancetype)initWithIdentifier:(NSString *)identifier processingQueue:(dispatch_queue_t)targetQueue;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMNetworkTask
+
+
+#pragma mark - Information
+
+- (CNMRequestPriority)priority {
+    
+    CNMRequestPriority priority = CNMRequestBackgroundPriority;
+    for (CNMBaseRequest *request in self.waiters.keyEnumerator) { priority = MIN(priority, request.priority); }
+    
+    return priority;
+}
+
+- (NSUInteger)maximumRetriesCount {
+    
+    NSUInteger count = 0;
+    for (CNMBaseRequest *request in self.waiters.keyEnumerator) { count = MAX(count, request.maximumRetriesCount); }
+    
+    return count;
+}
+
+- (BOOL)isHedgeable {
+    
+    for (CNMBaseRequest *request in self.waiters.keyEnumerator) {
+        
+        if (request.isHedgeable) { return YES; }
+    }
+    
+    return NO;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)taskWithIdentifier:(NSString *)identifier processingQueue:(dispatch_queue_t)targetQueue {
+    
+    return [[self alloc] initWithIdentifier:identifier processingQueue:targetQueue];
+}
+
+- (instancetype)initWithIdentifier:(NSString *)identifier processingQueue:(dispatch_queue_t)targetQueue {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _identifier = [identifier copy];
+        _processingQueue = dispatch_queue_create("com.continuumluxury.continuum.network.task",
+                                                 DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(_processingQueue, targetQueue);
+        _receivedData = [NSMutableData new];
+        _waiters = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory |
+                                                       NSPointerFunctionsObjectPointerPersonality)
+                                         valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Waiters
+
+- (BOOL)hasWaiters {
+    
+    return (self.waiters.count > 0);
+}
+
+- (void)addWaiter:(CNMBaseRequest *)request withBlock:(void(^)(id JSONObject, NSError *error))block {
+    
+    [self.waiters setObject:[block copy] forKey:request];
+}
+
+- (void(^)(id JSONObject, NSError *error))removeWaiter:(CNMBaseRequest *)request {
+    
+    void(^block)(id JSONObject, NSError *error) = [self.waiters objectForKey:request];
+    [self.waiters removeObjectForKey:request];
+    
+    return block;
+}
+
+- (NSArray<void(^)(id JSONObject, NSError *error)> *)removeAllWaiters {
+    
+    NSArray *blocks = [[self.waiters objectEnumerator] allObjects];
+    [self.waiters removeAllObjects];
+    
+    return blocks;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,169 @@
+#import <Foundation/Foundation.h>
+#import "CNMBaseRequest.h"
+
+
+#pragma mark Class forward
+
+@class CNMResponseCache, CNMNetworkWorkerPool, CNMRequestScheduler, CNMRequestResiliencePolicy, CNMNetworkMetrics;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Process-wide transport which send requests to remote data providers and process their responses.
+ @discussion Transport own single URL session (and so single connections pool), pool of workers which process
+             received data, scheduler and registry of in-flight tasks. Network managers is lightweight clients
+             of shared transport with their own headers and cancellation scope, so requests from all feeds and
+             player reuse same warm connections. Requests for same remote resource share single session task
+             and cached response only if they has been sent with same credentials.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMNetworkTransport : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores reference on cache which is used to store and revalidate responses for cacheable requests.
+ */
+@property (nonatomic, readonly, strong) CNMResponseCache *responseCache;
+
+/**
+ @brief      Stores reference on pool of workers which process received data.
+ @discussion Pool provide depth and wait time of each lane. While pool is saturated, tasks which process
+             responses in background lane suspended till pool will be drained.
+ */
+@property (nonatomic, readonly, strong) CNMNetworkWorkerPool *workerPool;
+
+/**
+ @brief      Stores reference on scheduler which decide when requests can be sent basing on their priority.
+ @discussion Scheduler provide time which requests of each priority spent in queue and on the wire.
+ */
+@property (nonatomic, readonly, strong) CNMRequestScheduler *scheduler;
+
+/**
+ @brief  Stores reference on policy which decide when failed requests should be repeated and when slow
+         requests should be duplicated.
+ */
+@property (nonatomic, readonly, strong) CNMRequestResiliencePolicy *resiliencePolicy;
+
+/**
+ @brief      Stores reference on measurements of requests which has been done by transport.
+ @discussion Along with timings and sizes, each request record whether it most likely has been sent over warm
+             connection which has been opened for one of previous requests.
+ */
+@property (nonatomic, readonly, strong) CNMNetworkMetrics *metrics;
+
+/**
+ @brief  Stores maximum number of requests which can be performed to same remote data provider at once.
+ */
+@property (nonatomic, readonly, assign) NSUInteger maximumConcurrentRequests;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Retrieve reference on transport which is shared by all network managers.
+ 
+ @return Configured and ready to use transport.
+ */
++ (instancetype)sharedTransport;
+
+/**
+ @brief      Create transport which doesn't share connections, response cache and measurements with shared
+             transport.
+ @discussion Requests sent over this transport doesn't change application's cached responses and metrics, so
+             it can be used to measure requests in isolation (for example by benchmarks).
+ 
+ @param name Name of directory inside of application's caches directory in which responses should be stored.
+ 
+ @return Configured and ready to use transport.
+ */
++ (instancetype)transportWithName:(NSString *)name;
+
+/**
+ @brief      Cancel all session tasks and release URL session.
+ @discussion URL session keep strong reference on transport, so transport which has been created with
+             \c +transportWithName: should be invalidated when it won't be used anymore. Shared transport
+             shouldn't be invalidated.
+ */
+- (void)invalidate;
+
+
+///------------------------------------------------
+/// @name Requests
+///------------------------------------------------
+
+/**
+ @brief      Perform network request and call completion block on specified queue.
+ @discussion If there is in-flight request for same remote resource with same \c Authorization header,
+             \c request will be attached to it and receive same processing results.
+ 
+ @param request    Reference on model which describe remote resource.
+ @param URLRequest Reference on URL request which should be sent for \c request (with client's headers).
+ @param decoder    Reference on block which receive binary representation of collection element and return
+                   object which should be stored in collection instead of it. If \c nil passed, elements will
+                   be parsed with \b NSJSONSerialization.
+ @param queue      Reference on queue on which \c block should be called.
+ @param block      Reference on block which pass two arguments: \c JSONObject - reference on parsed JSON object;
+                   \c error - reference on error which describe request issues.
+ */
+- (void)fetchJSONWithRequest:(CNMBaseRequest *)request URLRequest:(NSURLRequest *)URLRequest
+              elementDecoder:(nullable id _Nullable (^)(NSData *elementData))decoder
+               callbackQueue:(dispatch_queue_t)queue
+             completionBlock:(void(^)(id JSONObject, NSError * _Nullable error))block;
+
+/**
+ @brief  Change priority of request which already has been passed to the transport.
+ 
+ @param priority New request priority.
+ @param request  Reference on request instance for which priority should be changed.
+ */
+- (void)updatePriority:(CNMRequestPriority)priority forRequest:(CNMBaseRequest *)request;
+
+/**
+ @brief      Stop remote data request.
+ @discussion Network task will be stopped only when there is no other requests which wait for it. Completion
+             block which has been passed with \c request will be called with \c nil arguments.
+ 
+ @param request Reference on request instance which has required information about data request.
+ */
+- (void)cancelRequest:(CNMBaseRequest *)request;
+
+
+///------------------------------------------------
+/// @name Connections
+///------------------------------------------------
+
+/**
+ @brief      Open connection to remote data provider host before first request will be sent to it.
+ @discussion Lightweight \c HEAD request is sent to \c url, so DNS lookup, TCP and TLS handshakes done while
+             application prepare user interface and first real request reuse warm connection. Time which has
+             been saved by first request to the host is stored in \c metrics.
+ 
+ @param url Reference on remote data provider base URL.
+ */
+- (void)prewarmConnectionToURL:(NSURL *)url;
+
+/**
+ @brief      Resolve addresses of hosts to which connections will be opened by other loaders.
+ @discussion Resolved addresses cached by system resolver, so image and video loaders which doesn't use
+             transport's connections skip DNS lookup.
+ 
+ @param hosts List of host names which should be resolved.
+ */
+- (void)resolveHosts:(NSArray<NSString *> *)hosts;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
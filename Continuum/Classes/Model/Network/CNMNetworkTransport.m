@@ -0,0 +1,1070 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMNetworkTransport.h"
+#import <CommonCrypto/CommonDigest.h>
+#import <netdb.h>
+#import "CNMBaseRequest+Private.h"
+#import "CNMNetworkWorkerPool.h"
+#import "CNMRequestScheduler.h"
+#import "CNMRequestResiliencePolicy.h"
+#import "CNMNetworkMetrics.h"
+#import "CNMNetworkConditionsURLProtocol.h"
+#import "CNMReplayURLProtocol.h"
+#import "CNMJSONStreamParser.h"
+#import "CNMResponseCache.h"
+#import "CNMNetworkTask.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores how many workers can process user-initiated responses at once.
+ */
+static NSUInteger const kCNMMaximumConcurrentWorkers = 2;
+
+/**
+ @brief  Stores how long (in seconds) idle connection to remote data provider host most likely kept alive.
+ */
+static NSTimeInterval const kCNMConnectionKeepAliveInterval = 15.0f;
+
+/**
+ @brief  Stores name of endpoint under which connections pre-warm measurements is stored.
+ */
+static NSString * const kCNMPrewarmEndpoint = @"CNMConnectionPrewarm";
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMNetworkTransport () <NSURLSessionDataDelegate>
+
+
+#pragma mark - Properties
+
+@property (nonatomic, strong) CNMResponseCache *responseCache;
+@property (nonatomic, strong) CNMNetworkWorkerPool *workerPool;
+@property (nonatomic, strong) CNMRequestScheduler *scheduler;
+@property (nonatomic, strong) CNMRequestResiliencePolicy *resiliencePolicy;
+@property (nonatomic, strong) CNMNetworkMetrics *metrics;
+
+/**
+ @brief  Stores reference on session instance which is used to
+         send network requests.
+ */
+@property (nonatomic) NSURLSession *session;
+
+/**
+ @brief  Stores reference on serial queue which is used to access session and in-flight tasks registry.
+ */
+@property (nonatomic) dispatch_queue_t registryQueue;
+
+/**
+ @brief  Stores reference on in-flight tasks registry where each key is canonical remote resource identifier
+         and value is shared task which pull out data for it.
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, CNMNetworkTask *> *tasks;
+
+/**
+ @brief  Stores reference on dictionary where each key is session task identifier and value is shared task
+         which use it.
+ */
+@property (nonatomic) NSMutableDictionary<NSNumber *, CNMNetworkTask *> *activeTasks;
+
+/**
+ @brief  Stores reference on shared tasks which has been suspended while worker pool is saturated.
+ */
+@property (nonatomic) NSMutableSet<CNMNetworkTask *> *suspendedTasks;
+
+/**
+ @brief  Stores reference on dictionary where each key is remote data provider host and value is when session
+         task has been started, received response or completed for it last time.
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSNumber *> *hostActivityDates;
+
+/**
+ @brief  Stores reference on dictionary where each key is identifier of session task which pre-warm connection
+         and value is when it has been started.
+ */
+@property (nonatomic) NSMutableDictionary<NSNumber *, NSNumber *> *prewarmDataTasks;
+
+/**
+ @brief  Stores reference on dictionary where each key is pre-warmed host and value is time to first byte of
+         pre-warm session task (till first real request to the host will receive response).
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSNumber *> *prewarmFirstByteTimes;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize transport instance.
+ 
+ @param name Name of directory inside of application's caches directory in which responses should be stored. If
+             \c nil passed, shared response cache and metrics will be used.
+ 
+ @return Initialized and ready to use transport.
+ */
+- (instancetype)initWithName:(NSString *)name;
+
+
+#pragma mark - Handlers
+
+/**
+ @brief      Handle session task completion.
+ @discussion Response processed only once and results delivered to all requests which wait for shared task.
+             If resilience policy allow, shared task will be started again after failure instead.
+ 
+ @param dataTask     Reference on session task which has been used to pull out remote resource data.
+ @param requestError Reference on request processing error.
+ */
+- (void)handleCompletionOfDataTask:(NSURLSessionTask *)dataTask withError:(NSError *)requestError;
+
+/**
+ @brief  Handle worker pool drain and resume tasks which has been suspended while it was saturated.
+ */
+- (void)handleWorkerPoolDrain;
+
+/**
+ @brief  Handle scheduler decision to start shared task.
+ 
+ @param task Reference on shared task for which session task should be created and started.
+ */
+- (void)handleTaskStart:(CNMNetworkTask *)task;
+
+/**
+ @brief      Handle scheduler decision to preempt started shared task.
+ @discussion Session task is cancelled and data which may be received for it dropped, so task can be started
+             from the beginning later.
+ 
+ @param task Reference on shared task which should stop it's session task.
+ */
+- (void)handleTaskPreemption:(CNMNetworkTask *)task;
+
+/**
+ @brief      Handle case when session task didn't receive response in usual time.
+ @discussion If resilience policy allow, duplicate session task will be started and first received response
+             will be used.
+ 
+ @param task     Reference on shared task which wait for response.
+ @param dataTask Reference on session task which has been started for \c task.
+ */
+- (void)handleHedgeDelayExpirationForTask:(CNMNetworkTask *)task withDataTask:(NSURLSessionDataTask *)dataTask;
+
+/**
+ @brief  Handle response for session task which may pre-warm connection.
+ 
+ @param dataTask Reference on session task which received response.
+ 
+ @return \c YES in case if \c dataTask has been started to pre-warm connection.
+ */
+- (BOOL)handlePrewarmResponseForDataTask:(NSURLSessionTask *)dataTask;
+
+/**
+ @brief  Handle completion of session task which may pre-warm connection.
+ 
+ @param dataTask Reference on completed session task.
+ @param error    Reference on request processing error.
+ 
+ @return \c YES in case if \c dataTask has been started to pre-warm connection.
+ */
+- (BOOL)handlePrewarmCompletionOfDataTask:(NSURLSessionTask *)dataTask withError:(NSError *)error;
+
+
+#pragma mark - Retry
+
+/**
+ @brief      Schedule failed shared task start after randomized interval.
+ @discussion Task release it's scheduler slot while it wait for retry.
+ 
+ @param task Reference on shared task which should be started again.
+ */
+- (void)retryTask:(CNMNetworkTask *)task;
+
+/**
+ @brief      Start shared task again w/o conditional request header fields.
+ @discussion Used when remote resource not modified, but response body which has been stored for it can't be
+             found anymore.
+ 
+ @param task Reference on shared task which should be started again.
+ */
+- (void)repeatTaskWithoutConditions:(CNMNetworkTask *)task;
+
+
+#pragma mark - Misc
+
+/**
+ @brief      Store whether connection which is used by shared task most likely has been opened for one of
+             previous tasks.
+ @discussion Connection considered as warm if there has been activity on connection to the same host within
+             keep-alive interval.
+ 
+ @param task Reference on shared task which is about to start it's session task.
+ */
+- (void)recordConnectionUsageForTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Store when there has been activity on connection to remote data provider host.
+ 
+ @param request Reference on URL request which has been sent to the host.
+ */
+- (void)updateActivityDateForRequest:(NSURLRequest *)request;
+
+/**
+ @brief      Store how much time first request to pre-warmed host saved.
+ @discussion Should be called when shared task received response.
+ 
+ @param task Reference on shared task which received response.
+ */
+- (void)recordPrewarmSavedTimeForTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Find shared task which use specified session task.
+ 
+ @param dataTask Reference on session task for which shared task should be found.
+ 
+ @return Shared task or \c nil in case if it already completed.
+ */
+- (CNMNetworkTask *)taskForDataTask:(NSURLSessionTask *)dataTask;
+
+/**
+ @brief  Create and start session task which pull out data for shared task.
+ 
+ @param task Reference on shared task for which session task should be created.
+ 
+ @return Started session task.
+ */
+- (NSURLSessionDataTask *)startedDataTaskForTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Drop data which has been received for shared task, so it can be started from the beginning.
+ 
+ @param task Reference on shared task which data should be dropped.
+ */
+- (void)resetReceivedDataForTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Schedule block which process shared task data on worker pool.
+ 
+ @param block Reference on block which should be performed on task's processing queue.
+ @param task  Reference on shared task for which data should be processed.
+ */
+- (void)processBlock:(dispatch_block_t)block forTask:(CNMNetworkTask *)task;
+
+/**
+ @brief      Store measurements which has been done while shared task's response has been processed.
+ @discussion Should be called on task's processing queue right after response decoding completion.
+ 
+ @param task           Reference on shared task which response has been processed.
+ @param processingDate When response processing has been scheduled on worker pool.
+ @param decodeDate     When response decoding has been started.
+ */
+- (void)recordProcessingMetricsForTask:(CNMNetworkTask *)task withProcessingDate:(CFAbsoluteTime)processingDate
+                            decodeDate:(CFAbsoluteTime)decodeDate;
+
+/**
+ @brief  Process response which has been received for shared task.
+ 
+ @param task  Reference on shared task for which data has been received.
+ @param error Reference on pointer where processing error should be stored.
+ 
+ @return Parsed object which should be passed to requests which wait for \c task.
+ */
+- (id)processedObjectForTask:(CNMNetworkTask *)task withError:(NSError *__autoreleasing *)error;
+
+/**
+ @brief      Compose canonical remote resource identifier which is used to find in-flight tasks and cached
+             responses.
+ @discussion Clients with different credentials may have different access to same remote resource, so
+             identifier include digest of request's \c Authorization header.
+ 
+ @param request Reference on URL request (with client's headers) for which identifier should be composed.
+ 
+ @return Remote resource identifier.
+ */
+- (NSString *)identifierForRequest:(NSURLRequest *)request;
+
+/**
+ @brief  Compose digest which allow to distinguish clients w/o storing their credentials.
+ 
+ @param credentials Reference on value of \c Authorization header.
+ 
+ @return Hex-encoded \c SHA1 digest.
+ */
+- (NSString *)digestForCredentials:(NSString *)credentials;
+
+/**
+ @brief  Add to the request validators which has been received along with previously cached response.
+ 
+ @param request    Reference on URL request which should be revalidated.
+ @param identifier Canonical remote resource identifier.
+ 
+ @return Conditional request or original \c request in case if there is no cached response.
+ */
+- (NSURLRequest *)revalidationRequestFor:(NSURLRequest *)request withIdentifier:(NSString *)identifier;
+
+/**
+ @brief  Response cache which is shared between all transport instances.
+ 
+ @return Configured and ready to use response cache.
+ */
+- (CNMResponseCache *)sharedResponseCache;
+
+/**
+ @brief  Configure URL session instance for further usage with requests.
+ */
+- (void)prepareURLSession;
+
+/**
+ @brief  Network request session configuration.
+ 
+ @return Configured and ready to use session configuration instance.
+ */
+- (NSURLSessionConfiguration *)sessionConfiguration;
+
+/**
+ @brief      Requests operation queue (queue on which requests performed).
+ @discussion Queue is serial, so session deliver response, data chunks and completion of each task strictly
+             in order in which they has been received (streamed collection parser depend on it).
+ 
+ @param Reference on session configuration instance.
+ 
+ @return Configured and ready to use operations queue.
+ */
+- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration;
+
+/**
+ @brief  Initialize network session instance using user-provied configuration.
+ 
+ @param configuration Reference on session configuration instance.
+ 
+ @return Configured session for network request session.
+ */
+- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration;
+
+/**
+ @brief  Extract data received from remote data provider.
+ 
+ @param data                 Reference on data retrieved from remote data provider.
+ @param deserializationError Reference on pointer where de-serialization error should be stored.
+ */
+- (id)deserializedResponseFromData:(NSData *)data withError:(NSError *__autoreleasing *)deserializationError;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMNetworkTransport
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)sharedTransport {
+    
+    static CNMNetworkTransport *_sharedTransport;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{ _sharedTransport = [[self alloc] initWithName:nil]; });
+    
+    return _sharedTransport;
+}
+
++ (instancetype)transportWithName:(NSString *)name {
+    
+    return [[self alloc] initWithName:name];
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _workerPool = [CNMNetworkWorkerPool poolWithMaximumConcurrentWorkers:kCNMMaximumConcurrentWorkers];
+        _registryQueue = dispatch_queue_create("com.continuumluxury.continuum.network.registry",
+                                               DISPATCH_QUEUE_SERIAL);
+        _tasks = [NSMutableDictionary new];
+        _activeTasks = [NSMutableDictionary new];
+        _suspendedTasks = [NSMutableSet new];
+        _hostActivityDates = [NSMutableDictionary new];
+        _prewarmDataTasks = [NSMutableDictionary new];
+        _prewarmFirstByteTimes = [NSMutableDictionary new];
+        
+        __weak __typeof__(self) weakSelf = self;
+        _workerPool.drainHandler = ^{ [weakSelf handleWorkerPoolDrain]; };
+        _responseCache = (name ? [CNMResponseCache cacheWithName:name] : [self sharedResponseCache]);
+        _metrics = (name ? [CNMNetworkMetrics metrics] : [CNMNetworkMetrics sharedMetrics]);
+        [self prepareURLSession];
+        
+        _scheduler = [CNMRequestScheduler schedulerWithMaximumConcurrentRequests:self.maximumConcurrentRequests];
+        _scheduler.startHandler = ^(CNMNetworkTask *task) { [weakSelf handleTaskStart:task]; };
+        _scheduler.preemptionHandler = ^(CNMNetworkTask *task) { [weakSelf handleTaskPreemption:task]; };
+        _resiliencePolicy = [CNMRequestResiliencePolicy policy];
+    }
+    
+    return self;
+}
+
+- (void)invalidate {
+    
+    [self.session invalidateAndCancel];
+}
+
+
+#pragma mark - Information
+
+- (NSUInteger)maximumConcurrentRequests {
+    
+    return (NSUInteger)self.session.configuration.HTTPMaximumConnectionsPerHost;
+}
+
+
+#pragma mark - Requests
+
+- (void)fetchJSONWithRequest:(CNMBaseRequest *)request URLRequest:(NSURLRequest *)URLRequest
+              elementDecoder:(id(^)(NSData *elementData))decoder callbackQueue:(dispatch_queue_t)callbackQueue
+             completionBlock:(void(^)(id JSONObject, NSError *error))block {
+    
+    // Waiter's block deliver results to the queue which has been requested by caller.
+    NSString *requestType = NSStringFromClass(request.class);
+    CNMNetworkMetrics *metrics = self.metrics;
+    void(^waiterBlock)(id, NSError *) = ^(id JSONObject, NSError *error) {
+        
+        CFAbsoluteTime deliveryDate = CFAbsoluteTimeGetCurrent();
+        dispatch_async(callbackQueue, ^{
+            
+            NSTimeInterval deliveryTime = (CFAbsoluteTimeGetCurrent() - deliveryDate);
+            [metrics recordInterval:deliveryTime forMetric:CNMNetworkDeliveryTimeMetric ofEndpoint:requestType];
+            block(JSONObject, error);
+        });
+    };
+    NSString *identifier = [self identifierForRequest:URLRequest];
+    request.taskIdentifier = identifier;
+    BOOL usesResponseCache = request.shouldUseResponseCache;
+    NSString *collectionKey = request.streamedCollectionKey;
+    CNMRequestLane lane = request.lane;
+    dispatch_async(self.registryQueue, ^{
+        
+        // Attach to the task which already pull out data for same remote resource (if any).
+        CNMNetworkTask *task = self.tasks[identifier];
+        if (!task) {
+            
+            task = [CNMNetworkTask taskWithIdentifier:identifier
+                                      processingQueue:[self.workerPool targetQueueForLane:lane]];
+            task.usesResponseCache = usesResponseCache;
+            task.lane = lane;
+            task.requestType = requestType;
+            if (collectionKey) {
+                
+                task.parser = [CNMJSONStreamParser parserWithCollectionKey:collectionKey elementDecoder:decoder];
+            }
+            task.URLRequest = URLRequest;
+            if (usesResponseCache) {
+                
+                task.URLRequest = [self revalidationRequestFor:URLRequest withIdentifier:identifier];
+            }
+            self.tasks[identifier] = task;
+            [task addWaiter:request withBlock:waiterBlock];
+            [self.resiliencePolicy registerTask:task];
+            [self.scheduler scheduleTask:task];
+        }
+        else {
+            
+            [task addWaiter:request withBlock:waiterBlock];
+            [self.scheduler updatePriorityOfTask:task];
+        }
+    });
+}
+
+- (void)updatePriority:(CNMRequestPriority)priority forRequest:(CNMBaseRequest *)request {
+    
+    NSString *identifier = request.taskIdentifier;
+    dispatch_async(self.registryQueue, ^{
+        
+        request.priority = priority;
+        CNMNetworkTask *task = self.tasks[identifier];
+        if (task) { [self.scheduler updatePriorityOfTask:task]; }
+    });
+}
+
+- (void)cancelRequest:(CNMBaseRequest *)request {
+    
+    NSString *identifier = request.taskIdentifier;
+    dispatch_async(self.registryQueue, ^{
+        
+        CNMNetworkTask *task = self.tasks[identifier];
+        void(^block)(id JSONObject, NSError *error) = [task removeWaiter:request];
+        if (block) {
+            
+            // Network task should be stopped only when there is no more requests which wait for it.
+            if (!task.hasWaiters) {
+                
+                [self.tasks removeObjectForKey:identifier];
+                [task.dataTask cancel];
+                [task.hedgeDataTask cancel];
+                [self.scheduler completeTask:task];
+            }
+            else { [self.scheduler updatePriorityOfTask:task]; }
+            block(nil, nil);
+        }
+    });
+}
+
+
+#pragma mark - Connections
+
+- (void)prewarmConnectionToURL:(NSURL *)url {
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    request.cachePolicy = NSURLRequestReloadIgnoringCacheData;
+    request.HTTPMethod = @"HEAD";
+    dispatch_async(self.registryQueue, ^{
+        
+        NSURLSessionDataTask *dataTask = [self.session dataTaskWithRequest:request];
+        dataTask.priority = NSURLSessionTaskPriorityHigh;
+        self.prewarmDataTasks[@(dataTask.taskIdentifier)] = @(CFAbsoluteTimeGetCurrent());
+        [self updateActivityDateForRequest:request];
+        [dataTask resume];
+    });
+}
+
+- (void)resolveHosts:(NSArray<NSString *> *)hosts {
+    
+    for (NSString *host in hosts) {
+        
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+            
+            struct addrinfo *addresses = NULL;
+            if (getaddrinfo(host.UTF8String, "443", NULL, &addresses) == 0) { freeaddrinfo(addresses); }
+        });
+    }
+}
+
+
+#pragma mark - Handlers
+
+- (void)handleCompletionOfDataTask:(NSURLSessionTask *)dataTask withError:(NSError *)requestError {
+    
+    dispatch_async(self.registryQueue, ^{
+        
+        // Pre-warm session task only open connection for further requests.
+        if ([self handlePrewarmCompletionOfDataTask:dataTask withError:requestError]) { return; }
+        
+        // Session task has been preempted or lost race with duplicate session task.
+        CNMNetworkTask *task = self.activeTasks[@(dataTask.taskIdentifier)];
+        if (!task) { return; }
+        
+        [self.activeTasks removeObjectForKey:@(dataTask.taskIdentifier)];
+        [self updateActivityDateForRequest:dataTask.originalRequest];
+        if (task.hedgeDataTask && requestError) {
+            
+            // Response still can be received by other session task.
+            if (dataTask == task.dataTask) { task.dataTask = task.hedgeDataTask; }
+            task.hedgeDataTask = nil;
+            
+            return;
+        }
+        [self.suspendedTasks removeObject:task];
+        NSHTTPURLResponse *response = (NSHTTPURLResponse *)dataTask.response;
+        if (task.hasWaiters && [self.resiliencePolicy shouldRetryTask:task afterError:requestError
+                                                        withResponse:response]) {
+            
+            [self retryTask:task];
+            return;
+        }
+        if (task.hasWaiters && task.usesResponseCache && response.statusCode == 304 &&
+            ![self.responseCache hasResponseForIdentifier:task.identifier]) {
+            
+            [self repeatTaskWithoutConditions:task];
+            return;
+        }
+        CFAbsoluteTime processingDate = CFAbsoluteTimeGetCurrent();
+        if (task.responseDate > 0.0f) {
+            
+            [self.metrics recordInterval:(processingDate - task.responseDate) forMetric:CNMNetworkTransferTimeMetric
+                              ofEndpoint:task.requestType];
+        }
+        [self.scheduler completeTask:task];
+        if (self.tasks[task.identifier] == task) { [self.tasks removeObjectForKey:task.identifier]; }
+        NSArray<void(^)(id JSONObject, NSError *error)> *blocks = [task removeAllWaiters];
+        if (!blocks.count) { return; }
+        
+        // Processing queue used to make sure what all received data chunks has been processed.
+        [self processBlock:^{
+            
+            CFAbsoluteTime decodeDate = CFAbsoluteTimeGetCurrent();
+            NSError *processingError = nil;
+            id processedObject = [self processedObjectForTask:task withError:&processingError];
+            [self recordProcessingMetricsForTask:task withProcessingDate:processingDate decodeDate:decodeDate];
+            NSError *error = ((requestError.code == NSURLErrorCancelled ? nil : requestError)?:
+                              processingError);
+            for (void(^block)(id JSONObject, NSError *error) in blocks) { block(processedObject, error); }
+        } forTask:task];
+    });
+}
+
+- (void)handleTaskStart:(CNMNetworkTask *)task {
+    
+    task.responseDate = 0.0f;
+    [self recordConnectionUsageForTask:task];
+    task.dataTask = [self startedDataTaskForTask:task];
+    [self.metrics recordInterval:(task.startDate - task.scheduleDate) forMetric:CNMNetworkQueuedTimeMetric
+                      ofEndpoint:task.requestType];
+    NSTimeInterval hedgeDelay = [self.resiliencePolicy hedgeDelayForTask:task];
+    if (hedgeDelay > 0.0f) {
+        
+        __weak __typeof__(self) weakSelf = self;
+        NSURLSessionDataTask *dataTask = task.dataTask;
+        dispatch_time_t hedgeTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(hedgeDelay * NSEC_PER_SEC));
+        dispatch_after(hedgeTime, self.registryQueue, ^{
+            
+            [weakSelf handleHedgeDelayExpirationForTask:task withDataTask:dataTask];
+        });
+    }
+}
+
+- (void)handleTaskPreemption:(CNMNetworkTask *)task {
+    
+    [self.activeTasks removeObjectForKey:@(task.dataTask.taskIdentifier)];
+    [self.activeTasks removeObjectForKey:@(task.hedgeDataTask.taskIdentifier)];
+    [self.suspendedTasks removeObject:task];
+    [task.dataTask cancel];
+    [task.hedgeDataTask cancel];
+    task.dataTask = nil;
+    task.hedgeDataTask = nil;
+    [self resetReceivedDataForTask:task];
+}
+
+- (void)handleHedgeDelayExpirationForTask:(CNMNetworkTask *)task withDataTask:(NSURLSessionDataTask *)dataTask {
+    
+    // Response already arrived or session task has been stopped.
+    if (task.dataTask != dataTask || task.hedgeDataTask || dataTask.response ||
+        self.activeTasks[@(dataTask.taskIdentifier)] != task) {
+        
+        return;
+    }
+    
+    if ([self.resiliencePolicy shouldHedgeTask:task]) {
+        
+        task.hedgeDataTask = [self startedDataTaskForTask:task];
+#if DEBUG
+        NSLog(@"<Continuum::Network> Request with priority %lu hedged after %.2f ms",
+              (unsigned long)task.priority, (CFAbsoluteTimeGetCurrent() - task.startDate) * 1000.0f);
+#endif
+    }
+}
+
+- (BOOL)handlePrewarmResponseForDataTask:(NSURLSessionTask *)dataTask {
+    
+    NSNumber *startDate = self.prewarmDataTasks[@(dataTask.taskIdentifier)];
+    if (!startDate) { return NO; }
+    
+    NSTimeInterval firstByteTime = (CFAbsoluteTimeGetCurrent() - startDate.doubleValue);
+    NSString *host = dataTask.originalRequest.URL.host;
+    if (host) { self.prewarmFirstByteTimes[host] = @(firstByteTime); }
+    [self updateActivityDateForRequest:dataTask.originalRequest];
+    [self.metrics recordInterval:firstByteTime forMetric:CNMNetworkFirstByteTimeMetric
+                      ofEndpoint:kCNMPrewarmEndpoint];
+    
+    return YES;
+}
+
+- (BOOL)handlePrewarmCompletionOfDataTask:(NSURLSessionTask *)dataTask withError:(NSError *)error {
+    
+    if (!self.prewarmDataTasks[@(dataTask.taskIdentifier)]) { return NO; }
+    
+    [self.prewarmDataTasks removeObjectForKey:@(dataTask.taskIdentifier)];
+    [self updateActivityDateForRequest:dataTask.originalRequest];
+#if DEBUG
+    if (error) {
+        
+        NSLog(@"<Continuum::Network> Connection to %@ can't be pre-warmed: %@", dataTask.originalRequest.URL.host,
+              error);
+    }
+#endif
+    
+    return YES;
+}
+
+- (void)handleWorkerPoolDrain {
+    
+    dispatch_async(self.registryQueue, ^{
+        
+        for (CNMNetworkTask *task in self.suspendedTasks) { [task.dataTask resume]; }
+        [self.suspendedTasks removeAllObjects];
+    });
+}
+
+- (void)URLSession:(NSURLSession *)session didBecomeInvalidWithError:(NSError *)error {
+    
+    if (error) {
+        
+        dispatch_async(self.registryQueue, ^{ [self prepareURLSession]; });
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition disposition))completionHandler {
+    
+    __block CNMNetworkTask *task = nil;
+    __block BOOL prewarm = NO;
+    dispatch_sync(self.registryQueue, ^{
+        
+        task = self.activeTasks[@(dataTask.taskIdentifier)];
+        if (!task) {
+            
+            prewarm = [self handlePrewarmResponseForDataTask:dataTask];
+            return;
+        }
+        
+        task.responseDate = CFAbsoluteTimeGetCurrent();
+        [self updateActivityDateForRequest:dataTask.originalRequest];
+        [self.resiliencePolicy recordResponseLatency:(task.responseDate - task.startDate) forTask:task];
+        [self.metrics recordInterval:(task.responseDate - task.startDate) forMetric:CNMNetworkFirstByteTimeMetric
+                          ofEndpoint:task.requestType];
+        [self recordPrewarmSavedTimeForTask:task];
+        if (task.hedgeDataTask) {
+            
+            // First received response win and other session task is stopped.
+            NSURLSessionDataTask *lostDataTask = (dataTask == task.dataTask ? task.hedgeDataTask : task.dataTask);
+            if (dataTask == task.hedgeDataTask) { [self.resiliencePolicy recordHedgeWinForTask:task]; }
+            [self.activeTasks removeObjectForKey:@(lostDataTask.taskIdentifier)];
+            [lostDataTask cancel];
+            task.dataTask = dataTask;
+            task.hedgeDataTask = nil;
+        }
+    });
+    [self processBlock:^{ task.response = (NSHTTPURLResponse *)response; } forTask:task];
+    completionHandler(task || prewarm ? NSURLSessionResponseAllow : NSURLSessionResponseCancel);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask
+    didReceiveData:(NSData *)data {
+    
+    CNMNetworkTask *task = [self taskForDataTask:dataTask];
+    [self processBlock:^{
+        
+        // Only successful response can be decoded while it is arriving.
+        task.receivedBytesCount += data.length;
+        if (task.parser && task.response.statusCode == 200) { [task.parser appendData:data]; }
+        else { [task.receivedData appendData:data]; }
+    } forTask:task];
+    
+    // Background responses stop arriving while workers busy with responses which is waited by the user.
+    if (task.lane == CNMRequestBackgroundLane && self.workerPool.isSaturated) {
+        
+        dispatch_async(self.registryQueue, ^{
+            
+            if (self.activeTasks[@(dataTask.taskIdentifier)] == task && self.workerPool.isSaturated) {
+                
+                [dataTask suspend];
+                [self.suspendedTasks addObject:task];
+            }
+        });
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)dataTask
+didCompleteWithError:(NSError *)error {
+    
+    [self handleCompletionOfDataTask:dataTask withError:(error?: dataTask.error)];
+}
+
+
+#pragma mark - Retry
+
+- (void)retryTask:(CNMNetworkTask *)task {
+    
+    NSTimeInterval interval = [self.resiliencePolicy retryIntervalForTask:task];
+    task.retriesCount += 1;
+    [self.scheduler completeTask:task];
+    task.dataTask = nil;
+    [self resetReceivedDataForTask:task];
+#if DEBUG
+    NSLog(@"<Continuum::Network> Request with priority %lu will be repeated (attempt %lu) in %.2f ms",
+          (unsigned long)task.priority, (unsigned long)task.retriesCount, interval * 1000.0f);
+#endif
+    
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_time_t retryTime = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(interval * NSEC_PER_SEC));
+    dispatch_after(retryTime, self.registryQueue, ^{
+        
+        // All requests which has been waiting for task may be cancelled during retry interval.
+        __strong __typeof__(self) strongSelf = weakSelf;
+        if (strongSelf.tasks[task.identifier] == task && task.hasWaiters) {
+            
+            [strongSelf.scheduler scheduleTask:task];
+        }
+    });
+}
+
+- (void)repeatTaskWithoutConditions:(CNMNetworkTask *)task {
+    
+    [self.responseCache removeResponseForIdentifier:task.identifier];
+    NSMutableURLRequest *request = [task.URLRequest mutableCopy];
+    [request setValue:nil forHTTPHeaderField:@"If-None-Match"];
+    [request setValue:nil forHTTPHeaderField:@"If-Modified-Since"];
+    task.URLRequest = request;
+    [self.scheduler completeTask:task];
+    task.dataTask = nil;
+    [self resetReceivedDataForTask:task];
+    [self.scheduler scheduleTask:task];
+}
+
+
+#pragma mark - Misc
+
+- (void)recordConnectionUsageForTask:(CNMNetworkTask *)task {
+    
+    NSNumber *activityDate = self.hostActivityDates[task.URLRequest.URL.host ?: @""];
+    NSTimeInterval idleInterval = (CFAbsoluteTimeGetCurrent() - activityDate.doubleValue);
+    BOOL warm = (activityDate && idleInterval < kCNMConnectionKeepAliveInterval);
+    [self.metrics recordValue:(warm ? 1.0f : 0.0f) forMetric:CNMNetworkWarmConnectionMetric
+                   ofEndpoint:task.requestType];
+}
+
+- (void)updateActivityDateForRequest:(NSURLRequest *)request {
+    
+    if (request.URL.host) { self.hostActivityDates[request.URL.host] = @(CFAbsoluteTimeGetCurrent()); }
+}
+
+- (void)recordPrewarmSavedTimeForTask:(CNMNetworkTask *)task {
+    
+    NSString *host = task.URLRequest.URL.host;
+    NSNumber *prewarmFirstByteTime = (host ? self.prewarmFirstByteTimes[host] : nil);
+    if (!prewarmFirstByteTime) { return; }
+    
+    // Only first request to the host measured, because it would open connection if it wasn't pre-warmed.
+    [self.prewarmFirstByteTimes removeObjectForKey:host];
+    NSTimeInterval firstByteTime = (task.responseDate - task.startDate);
+    NSTimeInterval savedTime = MAX(prewarmFirstByteTime.doubleValue - firstByteTime, 0.0f);
+    [self.metrics recordInterval:savedTime forMetric:CNMNetworkPrewarmSavedTimeMetric ofEndpoint:task.requestType];
+#if DEBUG
+    NSLog(@"<Continuum::Network> First request to %@ received response in %.2f ms over connection pre-warmed in "
+          "%.2f ms (~%.2f ms saved)", host, firstByteTime * 1000.0f, prewarmFirstByteTime.doubleValue * 1000.0f,
+          savedTime * 1000.0f);
+#endif
+}
+
+- (CNMNetworkTask *)taskForDataTask:(NSURLSessionTask *)dataTask {
+    
+    __block CNMNetworkTask *task = nil;
+    dispatch_sync(self.registryQueue, ^{ task = self.activeTasks[@(dataTask.taskIdentifier)]; });
+    
+    return task;
+}
+
+- (NSURLSessionDataTask *)startedDataTaskForTask:(CNMNetworkTask *)task {
+    
+    NSURLSessionDataTask *dataTask = [self.session dataTaskWithRequest:task.URLRequest];
+    dataTask.priority = [CNMRequestScheduler sessionTaskPriorityForPriority:task.priority];
+    self.activeTasks[@(dataTask.taskIdentifier)] = task;
+    [self updateActivityDateForRequest:task.URLRequest];
+    [dataTask resume];
+    
+    return dataTask;
+}
+
+- (void)resetReceivedDataForTask:(CNMNetworkTask *)task {
+    
+    // Data which has been received before shouldn't be mixed with data from restarted task.
+    [self processBlock:^{
+        
+        task.response = nil;
+        task.receivedData.length = 0;
+        task.receivedBytesCount = 0;
+        [task.parser reset];
+    } forTask:task];
+}
+
+- (void)recordProcessingMetricsForTask:(CNMNetworkTask *)task withProcessingDate:(CFAbsoluteTime)processingDate
+                            decodeDate:(CFAbsoluteTime)decodeDate {
+    
+    NSString *endpoint = task.requestType;
+    long long compressedBytesCount = task.response.expectedContentLength;
+    if (compressedBytesCount < 0) { compressedBytesCount = (long long)task.receivedBytesCount; }
+    [self.metrics recordInterval:(decodeDate - processingDate) forMetric:CNMNetworkDecodeWaitTimeMetric
+                      ofEndpoint:endpoint];
+    [self.metrics recordInterval:(CFAbsoluteTimeGetCurrent() - decodeDate) forMetric:CNMNetworkDecodeTimeMetric
+                      ofEndpoint:endpoint];
+    [self.metrics recordValue:compressedBytesCount forMetric:CNMNetworkCompressedBytesMetric ofEndpoint:endpoint];
+    [self.metrics recordValue:task.receivedBytesCount forMetric:CNMNetworkDecompressedBytesMetric
+                   ofEndpoint:endpoint];
+}
+
+- (void)processBlock:(dispatch_block_t)block forTask:(CNMNetworkTask *)task {
+    
+    if (task) { [self.workerPool dispatchBlock:block toQueue:task.processingQueue inLane:task.lane]; }
+}
+
+- (id)processedObjectForTask:(CNMNetworkTask *)task withError:(NSError *__autoreleasing *)error {
+    
+    id processedObject = nil;
+    NSInteger statusCode = task.response.statusCode;
+    if (task.usesResponseCache && statusCode == 304) {
+        
+        // Remote resource not modified since last time, so previously processed object can be used.
+        processedObject = [self.responseCache objectForRevalidatedIdentifier:task.identifier
+                                                                  withParser:^id(NSData *data) {
+            
+            // Stored response body should be processed in same way as it has been done on receive.
+            NSError *parseError = nil;
+            if (!task.parser) { return [self deserializedResponseFromData:data withError:&parseError]; }
+            [task.parser appendData:data];
+            
+            return [task.parser finishWithError:&parseError];
+        }];
+        
+        // Stored response body has been lost after request has been sent.
+        if (!processedObject && error) {
+            
+            *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorResourceUnavailable
+                                     userInfo:@{NSURLErrorFailingURLErrorKey: task.URLRequest.URL}];
+        }
+    }
+    else {
+        
+        BOOL streamed = (task.parser && statusCode == 200);
+        NSData *data = (streamed ? task.parser.data : task.receivedData);
+        if (streamed) { processedObject = [task.parser finishWithError:error]; }
+        else { processedObject = [self deserializedResponseFromData:data withError:error]; }
+        
+        if (task.usesResponseCache && statusCode == 200) {
+            
+            [self.responseCache storeObject:processedObject withData:data forResponse:task.response
+                                 identifier:task.identifier];
+        }
+    }
+    
+    return processedObject;
+}
+
+- (NSString *)identifierForRequest:(NSURLRequest *)request {
+    
+    NSString *identifier = [NSString stringWithFormat:@"%@ %@", request.HTTPMethod, request.URL.absoluteString];
+    NSString *credentials = [request valueForHTTPHeaderField:@"Authorization"];
+    if (credentials.length) {
+        
+        identifier = [identifier stringByAppendingFormat:@" %@", [self digestForCredentials:credentials]];
+    }
+    
+    return identifier;
+}
+
+- (NSString *)digestForCredentials:(NSString *)credentials {
+    
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    NSData *credentialsData = [credentials dataUsingEncoding:NSUTF8StringEncoding];
+    CC_SHA1(credentialsData.bytes, (CC_LONG)credentialsData.length, digest);
+    NSMutableString *digestString = [NSMutableString stringWithCapacity:(CC_SHA1_DIGEST_LENGTH * 2)];
+    for (NSUInteger byteIdx = 0; byteIdx < CC_SHA1_DIGEST_LENGTH; byteIdx++) {
+        
+        [digestString appendFormat:@"%02x", digest[byteIdx]];
+    }
+    
+    return digestString;
+}
+
+- (NSURLRequest *)revalidationRequestFor:(NSURLRequest *)request withIdentifier:(NSString *)identifier {
+    
+    NSDictionary *headers = [self.responseCache validationHeadersForIdentifier:identifier];
+    if (headers.count) {
+        
+        NSMutableURLRequest *conditionalRequest = [request mutableCopy];
+        [headers enumerateKeysAndObjectsUsingBlock:^(NSString *field, NSString *value,
+                                                     BOOL *fieldsEnumeratorStop) {
+            
+            [conditionalRequest setValue:value forHTTPHeaderField:field];
+        }];
+        request = conditionalRequest;
+    }
+    
+    return request;
+}
+
+- (CNMResponseCache *)sharedResponseCache {
+    
+    static CNMResponseCache *_sharedResponseCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        
+        _sharedResponseCache = [CNMResponseCache cacheWithName:@"com.continuumluxury.continuum.responses"];
+    });
+    
+    return _sharedResponseCache;
+}
+
+- (void)prepareURLSession {
+    
+    _session = [self sessionWithConfiguration:[self sessionConfiguration]];
+}
+
+- (NSURLSessionConfiguration *)sessionConfiguration {
+    
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    configuration.URLCache = nil;
+    configuration.HTTPShouldUsePipelining = YES;
+    configuration.timeoutIntervalForRequest = 10.0f;
+    configuration.HTTPMaximumConnectionsPerHost = 5;
+    configuration.HTTPAdditionalHeaders = @{@"Accept-Encoding": @"gzip,deflate", @"Connection": @"keep-alive"};
+#if DEBUG
+    if ([CNMReplayURLProtocol isEnabled]) {
+        
+        configuration.protocolClasses = [@[CNMReplayURLProtocol.class]
+                                         arrayByAddingObjectsFromArray:configuration.protocolClasses];
+    }
+    
+    // Conditions simulator should be first to pass requests to replay stand-in by itself.
+    if ([CNMNetworkConditionsURLProtocol isEnabled]) {
+        
+        configuration.protocolClasses = [@[CNMNetworkConditionsURLProtocol.class]
+                                         arrayByAddingObjectsFromArray:configuration.protocolClasses];
+    }
+#endif
+    
+    return configuration;
+}
+
+- (NSOperationQueue *)operationQueueWithConfiguration:(NSURLSessionConfiguration *)configuration {
+    
+    NSOperationQueue *queue = [NSOperationQueue new];
+    queue.maxConcurrentOperationCount = 1;
+    
+    return queue;
+}
+
+- (NSURLSession *)sessionWithConfiguration:(NSURLSessionConfiguration *)configuration {
+    
+    NSOperationQueue *queue = [self operationQueueWithConfiguration:configuration];
+    
+    return [NSURLSession sessionWithConfiguration:configuration delegate:self
+                                    delegateQueue:queue];
+}
+
+- (id)deserializedResponseFromData:(NSData *)data withError:(NSError *__autoreleasing *)deserializationError {
+    
+    id deserializedResponse = nil;
+    if ([data length]) {
+        
+        @autoreleasepool {
+            
+            NSError *JSONDeserializationError = nil;
+            deserializedResponse = [NSJSONSerialization JSONObjectWithData:data
+                                                                   options:(NSJSONReadingOptions)0
+                                                                     error:&JSONDeserializationError];
+            *deserializationError = JSONDeserializationError;
+        }
+    }
+    
+    return deserializedResponse;
+}
+
+#pragma mark -
+
+
+@end
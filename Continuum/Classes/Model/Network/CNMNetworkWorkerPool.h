@@ -0,0 +1,109 @@
+#import <Foundation/Foundation.h>
+#import "CNMBaseRequest.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Bounded pool of workers which process received network data.
+ @discussion Each lane has fixed number of serial workers with own quality of service, so responses which is
+             waited by the user processed before background ones and burst of responses doesn't spawn thread
+             for each of them. Pool count blocks which has been scheduled but not completed yet: if there is
+             too many of them, pool report saturation and calls \c drainHandler as soon as half of them has been
+             completed. Instance is thread-safe.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMNetworkWorkerPool : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores maximum number of scheduled blocks after which pool is saturated.
+ */
+@property (nonatomic, readonly, assign) NSUInteger maximumDepth;
+
+/**
+ @brief  Stores whether number of scheduled blocks reached \c maximumDepth and background work should be slowed
+         down.
+ */
+@property (nonatomic, readonly, assign, getter = isSaturated) BOOL saturated;
+
+/**
+ @brief  Stores reference on block which is called on worker queue when saturated pool has been drained.
+ */
+@property (nonatomic, nullable, copy) dispatch_block_t drainHandler;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure worker pool.
+ 
+ @param count Number of workers which process user-initiated lane (background lane always has one worker).
+ 
+ @return Configured and ready to use worker pool.
+ */
++ (instancetype)poolWithMaximumConcurrentWorkers:(NSUInteger)count;
+
+
+///------------------------------------------------
+/// @name Workers
+///------------------------------------------------
+
+/**
+ @brief      Retrieve worker queue which should be used as target queue by serial queue which process data of
+             single response.
+ @discussion User-initiated lane workers assigned in round-robin manner.
+ 
+ @param lane Lane in which response should be processed.
+ 
+ @return Reference on worker queue.
+ */
+- (dispatch_queue_t)targetQueueForLane:(CNMRequestLane)lane;
+
+/**
+ @brief  Schedule block on queue which target one of lane workers.
+ 
+ @param block Reference on block which should be performed.
+ @param queue Reference on queue which has been configured with \c -targetQueueForLane:.
+ @param lane  Lane to which \c queue belongs.
+ */
+- (void)dispatchBlock:(dispatch_block_t)block toQueue:(dispatch_queue_t)queue inLane:(CNMRequestLane)lane;
+
+
+///------------------------------------------------
+/// @name Statistics
+///------------------------------------------------
+
+/**
+ @brief  Retrieve number of blocks which has been scheduled in lane and not completed yet.
+ 
+ @param lane Lane for which depth should be retrieved.
+ 
+ @return Number of blocks in lane.
+ */
+- (NSUInteger)depthOfLane:(CNMRequestLane)lane;
+
+/**
+ @brief  Retrieve smoothed time which blocks wait in lane before they will be performed.
+ 
+ @param lane Lane for which wait time should be retrieved.
+ 
+ @return Wait time in seconds.
+ */
+- (NSTimeInterval)waitTimeOfLane:(CNMRequestLane)lane;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
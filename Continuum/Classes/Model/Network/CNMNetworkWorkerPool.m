@@ -0,0 +1,218 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMNetworkWorkerPool.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores number of lanes which is handled by pool.
+ */
+static NSUInteger const kCNMWorkerPoolLanesCount = 2;
+
+/**
+ @brief  Stores maximum number of scheduled blocks after which pool is saturated.
+ */
+static NSUInteger const kCNMWorkerPoolMaximumDepth = 64;
+
+/**
+ @brief  Stores weight of new wait time measurement in smoothed value.
+ */
+static double const kCNMWaitTimeMeasurementWeight = 0.3f;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMNetworkWorkerPool () {
+    
+    /**
+     @brief  Stores number of blocks which has been scheduled in each lane and not completed yet.
+     */
+    NSUInteger _depths[kCNMWorkerPoolLanesCount];
+    
+    /**
+     @brief  Stores smoothed time which blocks wait in each lane before they will be performed.
+     */
+    NSTimeInterval _waitTimes[kCNMWorkerPoolLanesCount];
+}
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger maximumDepth;
+@property (nonatomic, assign, getter = isSaturated) BOOL saturated;
+
+/**
+ @brief  Stores reference on serial workers which process user-initiated lane.
+ */
+@property (nonatomic) NSArray<dispatch_queue_t> *userInitiatedWorkers;
+
+/**
+ @brief  Stores reference on serial worker which process background lane.
+ */
+@property (nonatomic) dispatch_queue_t backgroundWorker;
+
+/**
+ @brief  Stores index of user-initiated lane worker which will be assigned to next response.
+ */
+@property (nonatomic, assign) NSUInteger nextWorkerIndex;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to pool statistics.
+ */
+@property (nonatomic) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize worker pool.
+ 
+ @param count Number of workers which process user-initiated lane.
+ 
+ @return Initialized and ready to use worker pool.
+ */
+- (instancetype)initWithMaximumConcurrentWorkers:(NSUInteger)count;
+
+
+#pragma mark - Statistics
+
+/**
+ @brief  Update lane statistics when scheduled block has been completed.
+ 
+ @param lane     Lane in which block has been performed.
+ @param waitTime How long block waited for worker (in seconds).
+ */
+- (void)completeBlockInLane:(CNMRequestLane)lane afterWaitTime:(NSTimeInterval)waitTime;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMNetworkWorkerPool
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)poolWithMaximumConcurrentWorkers:(NSUInteger)count {
+    
+    return [[self alloc] initWithMaximumConcurrentWorkers:count];
+}
+
+- (instancetype)initWithMaximumConcurrentWorkers:(NSUInteger)count {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _maximumDepth = kCNMWorkerPoolMaximumDepth;
+        dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL,
+                                                                                   QOS_CLASS_USER_INITIATED, 0);
+        NSMutableArray<dispatch_queue_t> *workers = [NSMutableArray new];
+        for (NSUInteger workerIdx = 0; workerIdx < MAX(count, 1); workerIdx++) {
+            
+            [workers addObject:dispatch_queue_create("com.continuumluxury.continuum.network.worker", attributes)];
+        }
+        _userInitiatedWorkers = [workers copy];
+        attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0);
+        _backgroundWorker = dispatch_queue_create("com.continuumluxury.continuum.network.worker.background",
+                                                  attributes);
+        _resourceAccessQueue = dispatch_queue_create("com.continuumluxury.continuum.network.pool",
+                                                     DISPATCH_QUEUE_SERIAL);
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Workers
+
+- (dispatch_queue_t)targetQueueForLane:(CNMRequestLane)lane {
+    
+    if (lane == CNMRequestBackgroundLane) { return self.backgroundWorker; }
+    
+    __block dispatch_queue_t worker = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        worker = self.userInitiatedWorkers[self.nextWorkerIndex];
+        self.nextWorkerIndex = (self.nextWorkerIndex + 1) % self.userInitiatedWorkers.count;
+    });
+    
+    return worker;
+}
+
+- (void)dispatchBlock:(dispatch_block_t)block toQueue:(dispatch_queue_t)queue inLane:(CNMRequestLane)lane {
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        _depths[lane]++;
+        if (!self.saturated && _depths[CNMRequestUserInitiatedLane] + _depths[CNMRequestBackgroundLane] >=
+            self.maximumDepth) {
+            
+            self.saturated = YES;
+#if DEBUG
+            NSLog(@"<Continuum::Network> Worker pool saturated (%lu user-initiated and %lu background blocks)",
+                  (unsigned long)_depths[CNMRequestUserInitiatedLane],
+                  (unsigned long)_depths[CNMRequestBackgroundLane]);
+#endif
+        }
+    });
+    
+    CFAbsoluteTime scheduleDate = CFAbsoluteTimeGetCurrent();
+    dispatch_async(queue, ^{
+        
+        NSTimeInterval waitTime = (CFAbsoluteTimeGetCurrent() - scheduleDate);
+        block();
+        [self completeBlockInLane:lane afterWaitTime:waitTime];
+    });
+}
+
+
+#pragma mark - Statistics
+
+- (NSUInteger)depthOfLane:(CNMRequestLane)lane {
+    
+    __block NSUInteger depth = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{ depth = _depths[lane]; });
+    
+    return depth;
+}
+
+- (NSTimeInterval)waitTimeOfLane:(CNMRequestLane)lane {
+    
+    __block NSTimeInterval waitTime = 0.0f;
+    dispatch_sync(self.resourceAccessQueue, ^{ waitTime = _waitTimes[lane]; });
+    
+    return waitTime;
+}
+
+- (void)completeBlockInLane:(CNMRequestLane)lane afterWaitTime:(NSTimeInterval)waitTime {
+    
+    __block BOOL drained = NO;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        _depths[lane]--;
+        if (_waitTimes[lane] <= 0.0f) { _waitTimes[lane] = waitTime; }
+        else { _waitTimes[lane] += (waitTime - _waitTimes[lane]) * kCNMWaitTimeMeasurementWeight; }
+        
+        // Background work resumed only when there is enough space for it.
+        if (self.saturated && _depths[CNMRequestUserInitiatedLane] + _depths[CNMRequestBackgroundLane] <=
+            self.maximumDepth / 2) {
+            
+            self.saturated = NO;
+            drained = YES;
+        }
+    });
+    if (drained && self.drainHandler) { self.drainHandler(); }
+}
+
+#pragma mark -
+
+
+@end
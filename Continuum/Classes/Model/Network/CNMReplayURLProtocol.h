@@ -0,0 +1,63 @@
+#import <Foundation/Foundation.h>
+
+
+#if DEBUG
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Local stand-in for remote data provider which replay recorded responses.
+ @discussion Protocol handle requests to \c +baseURL host and respond with recorded response body for same path
+             and query (recordings stored in directory as one file per resource). Responses delivered after
+             configured latency and in chunks with configured bandwidth, so feed loading can be measured
+             reproducibly. If upstream URL is set, missing recordings fetched from it and stored (record mode).
+             Protocol used by network manager's session only (not registered globally) and should be configured
+             before network manager creation. Available only in debug builds and can be enabled with
+             \c -CNMReplayRecordings \c <path> launch argument (\c -CNMReplayLatency in milliseconds,
+             \c -CNMReplayBandwidth in KB/s and \c -CNMReplayRecord \c YES are optional).
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMReplayURLProtocol : NSURLProtocol
+
+
+///------------------------------------------------
+/// @name Configuration
+///------------------------------------------------
+
+/**
+ @brief  Retrieve base URL which should be used by requests to reach stand-in.
+ 
+ @return Stand-in base URL.
+ */
++ (NSURL *)baseURL;
+
+/**
+ @brief  Retrieve whether stand-in has been configured with recordings directory.
+ 
+ @return \c YES in case if requests to \c +baseURL can be handled.
+ */
++ (BOOL)isEnabled;
+
+/**
+ @brief  Configure stand-in.
+ 
+ @param path        Full path to the directory with recorded responses.
+ @param latency     Time (in seconds) after which response should be received.
+ @param bandwidth   Number of bytes which can be delivered per second (\c 0 for unlimited).
+ @param upstreamURL Reference on remote data provider base URL from which missing recordings should be fetched
+                    (\c nil to replay only).
+ */
++ (void)setRecordingsPath:(NSString *)path latency:(NSTimeInterval)latency bandwidth:(NSUInteger)bandwidth
+              upstreamURL:(nullable NSURL *)upstreamURL;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif // DEBUG
@@ -0,0 +1,267 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMReplayURLProtocol.h"
+#if DEBUG
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores base URL which is handled by stand-in.
+ */
+static NSString * const kCNMReplayBaseURL = @"http://replay.continuum.local";
+
+/**
+ @brief  Stores interval (in seconds) between response body chunks delivery.
+ */
+static NSTimeInterval const kCNMReplayChunkInterval = 0.05f;
+
+/**
+ @brief  Stores stand-in configuration which is shared by all protocol instances.
+ */
+static NSString *CNMReplayRecordingsPath;
+static NSTimeInterval CNMReplayLatency;
+static NSUInteger CNMReplayBandwidth;
+static NSURL *CNMReplayUpstreamURL;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMReplayURLProtocol ()
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on thread on which protocol has been started (client should be notified on it).
+ */
+@property (nonatomic) NSThread *clientThread;
+
+/**
+ @brief  Stores reference on run loop mode in which protocol has been started.
+ */
+@property (nonatomic, copy) NSString *runLoopMode;
+
+/**
+ @brief  Stores reference on task which fetch missing recording from upstream.
+ */
+@property (nonatomic, nullable) NSURLSessionDataTask *upstreamTask;
+
+/**
+ @brief  Stores reference on response which should be delivered to the client after latency.
+ */
+@property (nonatomic, nullable) NSHTTPURLResponse *response;
+
+/**
+ @brief  Stores reference on response body which is delivered to the client.
+ */
+@property (nonatomic) NSData *body;
+
+/**
+ @brief  Stores number of body bytes which already has been delivered to the client.
+ */
+@property (nonatomic, assign) NSUInteger deliveredBytesCount;
+
+/**
+ @brief  Stores reference on timer which deliver response body chunks.
+ */
+@property (nonatomic, nullable) NSTimer *deliveryTimer;
+
+
+#pragma mark - Recordings
+
+/**
+ @brief  Compose path to the file which store recorded response for remote resource.
+ 
+ @param url Reference on remote resource URL.
+ 
+ @return Full path to recording file.
+ */
++ (NSString *)recordingPathForURL:(NSURL *)url;
+
+/**
+ @brief  Fetch remote resource from upstream and store it as recording.
+ 
+ @param path Full path to the file where recording should be stored.
+ */
+- (void)fetchRecordingToPath:(NSString *)path;
+
+
+#pragma mark - Delivery
+
+/**
+ @brief  Schedule response delivery to the client.
+ 
+ @param body Reference on recorded response body or \c nil in case if there is no recording.
+ */
+- (void)startDeliveryOfBody:(nullable NSData *)body;
+
+/**
+ @brief  Deliver response (if not delivered yet) and next body chunk which fit into bandwidth.
+ */
+- (void)deliverNextChunk;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMReplayURLProtocol
+
+
+#pragma mark - Configuration
+
++ (NSURL *)baseURL {
+    
+    return [NSURL URLWithString:kCNMReplayBaseURL];
+}
+
++ (BOOL)isEnabled {
+    
+    return (CNMReplayRecordingsPath.length > 0);
+}
+
++ (void)setRecordingsPath:(NSString *)path latency:(NSTimeInterval)latency bandwidth:(NSUInteger)bandwidth
+              upstreamURL:(NSURL *)upstreamURL {
+    
+    CNMReplayRecordingsPath = [path copy];
+    CNMReplayLatency = MAX(latency, 0.0f);
+    CNMReplayBandwidth = bandwidth;
+    CNMReplayUpstreamURL = upstreamURL;
+}
+
+
+#pragma mark - Protocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    
+    return ([self isEnabled] && [request.URL.host isEqualToString:[self baseURL].host]);
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    
+    return request;
+}
+
+- (void)startLoading {
+    
+    self.clientThread = [NSThread currentThread];
+    self.runLoopMode = ([NSRunLoop currentRunLoop].currentMode ?: NSDefaultRunLoopMode);
+    NSString *path = [[self class] recordingPathForURL:self.request.URL];
+    NSData *body = [NSData dataWithContentsOfFile:path];
+    if (!body && CNMReplayUpstreamURL) { [self fetchRecordingToPath:path]; }
+    else { [self startDeliveryOfBody:body]; }
+}
+
+- (void)stopLoading {
+    
+    [self.upstreamTask cancel];
+    [self.deliveryTimer invalidate];
+    self.deliveryTimer = nil;
+}
+
+
+#pragma mark - Recordings
+
++ (NSString *)recordingPathForURL:(NSURL *)url {
+    
+    NSString *resource = (url.query.length ? [NSString stringWithFormat:@"%@?%@", url.path, url.query] : url.path);
+    NSCharacterSet *separators = [NSCharacterSet alphanumericCharacterSet].invertedSet;
+    NSString *name = [[resource componentsSeparatedByCharactersInSet:separators] componentsJoinedByString:@"_"];
+    
+    return [CNMReplayRecordingsPath stringByAppendingPathComponent:[name stringByAppendingPathExtension:@"json"]];
+}
+
+- (void)fetchRecordingToPath:(NSString *)path {
+    
+    NSURLComponents *components = [NSURLComponents componentsWithURL:self.request.URL resolvingAgainstBaseURL:YES];
+    components.scheme = CNMReplayUpstreamURL.scheme;
+    components.host = CNMReplayUpstreamURL.host;
+    components.port = CNMReplayUpstreamURL.port;
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    request.URL = components.URL;
+    
+    // Full response body should be recorded, so conditional request can't be used.
+    [request setValue:nil forHTTPHeaderField:@"If-None-Match"];
+    [request setValue:nil forHTTPHeaderField:@"If-Modified-Since"];
+    
+    __weak __typeof__(self) weakSelf = self;
+    self.upstreamTask = [[NSURLSession sharedSession] dataTaskWithRequest:request
+                                                        completionHandler:^(NSData *data, NSURLResponse *response,
+                                                                            NSError *error) {
+        
+        BOOL recorded = (!error && ((NSHTTPURLResponse *)response).statusCode == 200 && data.length);
+        if (recorded) {
+            
+            [[NSFileManager defaultManager] createDirectoryAtPath:CNMReplayRecordingsPath
+                                      withIntermediateDirectories:YES attributes:nil error:nil];
+            [data writeToFile:path atomically:YES];
+        }
+        
+        __strong __typeof__(self) strongSelf = weakSelf;
+        if (strongSelf.clientThread) {
+            
+            [strongSelf performSelector:@selector(startDeliveryOfBody:) onThread:strongSelf.clientThread
+                             withObject:(recorded ? data : nil) waitUntilDone:NO modes:@[strongSelf.runLoopMode]];
+        }
+    }];
+    [self.upstreamTask resume];
+}
+
+
+#pragma mark - Delivery
+
+- (void)startDeliveryOfBody:(NSData *)body {
+    
+    self.body = (body ?: [@"{}" dataUsingEncoding:NSUTF8StringEncoding]);
+    NSString *length = [NSString stringWithFormat:@"%lu", (unsigned long)self.body.length];
+    NSDictionary *headers = @{@"Content-Type": @"application/json", @"Content-Length": length};
+    self.response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:(body ? 200 : 404)
+                                               HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    self.deliveryTimer = [[NSTimer alloc] initWithFireDate:[NSDate dateWithTimeIntervalSinceNow:CNMReplayLatency]
+                                                  interval:kCNMReplayChunkInterval target:self
+                                                  selector:@selector(deliverNextChunk) userInfo:nil repeats:YES];
+    [[NSRunLoop currentRunLoop] addTimer:self.deliveryTimer forMode:self.runLoopMode];
+}
+
+- (void)deliverNextChunk {
+    
+    if (self.response) {
+        
+        [self.client URLProtocol:self didReceiveResponse:self.response
+              cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+        self.response = nil;
+    }
+    
+    NSUInteger length = (self.body.length - self.deliveredBytesCount);
+    if (CNMReplayBandwidth > 0) {
+        
+        length = MIN(length, MAX((NSUInteger)(CNMReplayBandwidth * kCNMReplayChunkInterval), 1));
+    }
+    if (length) {
+        
+        NSData *chunk = [self.body subdataWithRange:NSMakeRange(self.deliveredBytesCount, length)];
+        self.deliveredBytesCount += length;
+        [self.client URLProtocol:self didLoadData:chunk];
+    }
+    
+    if (self.deliveredBytesCount == self.body.length) {
+        
+        [self.deliveryTimer invalidate];
+        self.deliveryTimer = nil;
+        [self.client URLProtocolDidFinishLoading:self];
+    }
+}
+
+#pragma mark -
+
+
+@end
+
+#endif // DEBUG
@@ -0,0 +1,146 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class CNMNetworkTask;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Policy which decide when shared network tasks should be repeated or duplicated to cut off tail
+             latency.
+ @discussion Only idempotent (GET) tasks can be repeated. Task repeated after timeout, lost connection or server
+             error while it's retries budget (declared by request class) not exhausted. Interval before retry
+             grow exponentially with each attempt and randomized, so clients won't retry in sync.
+             If request class allow hedging, duplicate session task started when response doesn't arrive in
+             95th percentile of response times measured for same request class. First received response used
+             and other session task cancelled.
+             Retries and hedges together can't exceed 10% of registered tasks (with small reserve for
+             application launch), so remote data provider which is already in trouble won't get more load.
+             Instance is not thread-safe and should be used from single serial queue (counters can be read from
+             any queue).
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMRequestResiliencePolicy : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores how many tasks has been registered.
+ */
+@property (nonatomic, readonly, assign) NSUInteger requestsCount;
+
+/**
+ @brief  Stores how many times tasks has been repeated.
+ */
+@property (nonatomic, readonly, assign) NSUInteger retriesCount;
+
+/**
+ @brief  Stores how many duplicate session tasks has been started.
+ */
+@property (nonatomic, readonly, assign) NSUInteger hedgesCount;
+
+/**
+ @brief  Stores how many times duplicate session task received response before original one.
+ */
+@property (nonatomic, readonly, assign) NSUInteger hedgeWinsCount;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure resilience policy.
+ 
+ @return Configured and ready to use policy.
+ */
++ (instancetype)policy;
+
+
+///------------------------------------------------
+/// @name Retry
+///------------------------------------------------
+
+/**
+ @brief  Register new task (registered tasks count define how many retries and hedges can be done).
+ 
+ @param task Reference on shared task which has been created.
+ */
+- (void)registerTask:(CNMNetworkTask *)task;
+
+/**
+ @brief      Check whether task should be repeated after it's session task completion.
+ @discussion If \c YES returned, retry counted in load budget.
+ 
+ @param task     Reference on shared task which session task has been completed.
+ @param error    Reference on session task completion error.
+ @param response Reference on response which has been received by session task.
+ 
+ @return \c YES in case if task can be started again.
+ */
+- (BOOL)shouldRetryTask:(CNMNetworkTask *)task afterError:(nullable NSError *)error
+           withResponse:(nullable NSHTTPURLResponse *)response;
+
+/**
+ @brief  Calculate randomized interval after which task should be repeated.
+ 
+ @param task Reference on shared task which should be repeated (interval depends on it's \c retriesCount).
+ 
+ @return Interval in seconds.
+ */
+- (NSTimeInterval)retryIntervalForTask:(CNMNetworkTask *)task;
+
+
+///------------------------------------------------
+/// @name Hedging
+///------------------------------------------------
+
+/**
+ @brief  Calculate how long task's session task may wait for response before duplicate will be started.
+ 
+ @param task Reference on shared task which has been started.
+ 
+ @return Interval in seconds or \c 0 in case if task can't be duplicated or there is not enough measurements.
+ */
+- (NSTimeInterval)hedgeDelayForTask:(CNMNetworkTask *)task;
+
+/**
+ @brief      Check whether duplicate session task can be started.
+ @discussion If \c YES returned, hedge counted in load budget.
+ 
+ @param task Reference on shared task which didn't receive response in time.
+ 
+ @return \c YES in case if duplicate session task can be started.
+ */
+- (BOOL)shouldHedgeTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Store how long task waited for response.
+ 
+ @param latency Interval (in seconds) between session task start and response receive.
+ @param task    Reference on shared task which received response.
+ */
+- (void)recordResponseLatency:(NSTimeInterval)latency forTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Store that duplicate session task received response before original one.
+ 
+ @param task Reference on shared task which received response.
+ */
+- (void)recordHedgeWinForTask:(CNMNetworkTask *)task;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,307 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMRequestResiliencePolicy.h"
+#import "CNMNetworkTask.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores maximum number of response times which is stored for each request class.
+ */
+static NSUInteger const kCNMLatencySamplesCount = 64;
+
+/**
+ @brief  Stores minimum number of response times which should be measured before tasks can be duplicated.
+ */
+static NSUInteger const kCNMMinimumLatencySamplesCount = 20;
+
+/**
+ @brief  Stores percentile of response times after which task can be duplicated.
+ */
+static double const kCNMHedgeLatencyPercentile = 0.95f;
+
+/**
+ @brief  Stores interval (in seconds) which is used to calculate interval before first retry.
+ */
+static NSTimeInterval const kCNMRetryBaseInterval = 0.25f;
+
+/**
+ @brief  Stores maximum interval (in seconds) before retry.
+ */
+static NSTimeInterval const kCNMRetryMaximumInterval = 4.0f;
+
+/**
+ @brief  Stores which part of registered tasks can be repeated or duplicated.
+ */
+static double const kCNMExtraRequestsRatio = 0.1f;
+
+/**
+ @brief  Stores number of retries and hedges which can be done before there will be enough registered tasks.
+ */
+static NSUInteger const kCNMExtraRequestsReserve = 5;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMRequestResiliencePolicy () {
+    
+    /**
+     @brief  Stores how many tasks has been registered.
+     */
+    NSUInteger _requestsCount;
+    
+    /**
+     @brief  Stores how many times tasks has been repeated.
+     */
+    NSUInteger _retriesCount;
+    
+    /**
+     @brief  Stores how many duplicate session tasks has been started.
+     */
+    NSUInteger _hedgesCount;
+    
+    /**
+     @brief  Stores how many times duplicate session task received response before original one.
+     */
+    NSUInteger _hedgeWinsCount;
+}
+
+
+#pragma mark - Properties
+
+/**
+ @brief  Stores reference on dictionary where each key is request class name and value is list of last measured
+         response times (in seconds).
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *latencies;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to counters.
+ */
+@property (nonatomic) dispatch_queue_t statisticsAccessQueue;
+
+
+#pragma mark - Misc
+
+/**
+ @brief  Check whether there is place for one more retry or hedge in load budget.
+ 
+ @param counter Reference on counter which should be increased if there is place in budget.
+ 
+ @return \c YES in case if \c counter has been increased.
+ */
+- (BOOL)reserveExtraRequestInCounter:(NSUInteger *)counter;
+
+/**
+ @brief  Retrieve current counter value.
+ 
+ @param counter Reference on counter which should be read.
+ 
+ @return Counter value.
+ */
+- (NSUInteger)valueOfCounter:(NSUInteger *)counter;
+
+/**
+ @brief  Increase counter value.
+ 
+ @param counter Reference on counter which should be increased.
+ */
+- (void)increaseCounter:(NSUInteger *)counter;
+
+/**
+ @brief  Check whether session task error is temporary and request may succeed if it will be repeated.
+ 
+ @param error Reference on session task completion error.
+ 
+ @return \c YES in case if request can be repeated.
+ */
+- (BOOL)isTransientError:(NSError *)error;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMRequestResiliencePolicy
+
+
+#pragma mark - Information
+
+- (NSUInteger)requestsCount {
+    
+    return [self valueOfCounter:&_requestsCount];
+}
+
+- (NSUInteger)retriesCount {
+    
+    return [self valueOfCounter:&_retriesCount];
+}
+
+- (NSUInteger)hedgesCount {
+    
+    return [self valueOfCounter:&_hedgesCount];
+}
+
+- (NSUInteger)hedgeWinsCount {
+    
+    return [self valueOfCounter:&_hedgeWinsCount];
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)policy {
+    
+    return [self new];
+}
+
+- (instancetype)init {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _latencies = [NSMutableDictionary new];
+        _statisticsAccessQueue = dispatch_queue_create("com.continuumluxury.continuum.network.resilience",
+                                                       DISPATCH_QUEUE_SERIAL);
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Retry
+
+- (void)registerTask:(CNMNetworkTask *)task {
+    
+    [self increaseCounter:&_requestsCount];
+}
+
+- (BOOL)shouldRetryTask:(CNMNetworkTask *)task afterError:(NSError *)error
+           withResponse:(NSHTTPURLResponse *)response {
+    
+    NSInteger statusCode = response.statusCode;
+    BOOL shouldRetry = ([self isTransientError:error] || (!error && (statusCode == 429 || statusCode >= 500)));
+    
+    // Parser already decoded part of streamed response and can't start from the beginning.
+    if (task.parser && statusCode == 200) { shouldRetry = NO; }
+    if (shouldRetry && [task.URLRequest.HTTPMethod isEqualToString:@"GET"] &&
+        task.retriesCount < task.maximumRetriesCount) {
+        
+        return [self reserveExtraRequestInCounter:&_retriesCount];
+    }
+    
+    return NO;
+}
+
+- (NSTimeInterval)retryIntervalForTask:(CNMNetworkTask *)task {
+    
+    NSTimeInterval interval = MIN(kCNMRetryBaseInterval * pow(2.0f, task.retriesCount), kCNMRetryMaximumInterval);
+    
+    // Random part of interval spread retries from different clients.
+    return (interval * (arc4random_uniform(1001) / 1000.0f));
+}
+
+
+#pragma mark - Hedging
+
+- (NSTimeInterval)hedgeDelayForTask:(CNMNetworkTask *)task {
+    
+    NSArray<NSNumber *> *samples = self.latencies[task.requestType];
+    if (!task.isHedgeable || ![task.URLRequest.HTTPMethod isEqualToString:@"GET"] ||
+        samples.count < kCNMMinimumLatencySamplesCount) {
+        
+        return 0.0f;
+    }
+    
+    NSArray<NSNumber *> *sortedSamples = [samples sortedArrayUsingSelector:@selector(compare:)];
+    NSUInteger position = (NSUInteger)ceil(sortedSamples.count * kCNMHedgeLatencyPercentile) - 1;
+    
+    return sortedSamples[position].doubleValue;
+}
+
+- (BOOL)shouldHedgeTask:(CNMNetworkTask *)task {
+    
+    return [self reserveExtraRequestInCounter:&_hedgesCount];
+}
+
+- (void)recordResponseLatency:(NSTimeInterval)latency forTask:(CNMNetworkTask *)task {
+    
+    NSMutableArray<NSNumber *> *samples = self.latencies[task.requestType];
+    if (!samples) {
+        
+        samples = [NSMutableArray arrayWithCapacity:kCNMLatencySamplesCount];
+        self.latencies[task.requestType] = samples;
+    }
+    if (samples.count == kCNMLatencySamplesCount) { [samples removeObjectAtIndex:0]; }
+    [samples addObject:@(latency)];
+}
+
+- (void)recordHedgeWinForTask:(CNMNetworkTask *)task {
+    
+    [self increaseCounter:&_hedgeWinsCount];
+}
+
+
+#pragma mark - Misc
+
+- (BOOL)reserveExtraRequestInCounter:(NSUInteger *)counter {
+    
+    __block BOOL reserved = NO;
+    dispatch_sync(self.statisticsAccessQueue, ^{
+        
+        NSUInteger limit = (kCNMExtraRequestsReserve + (NSUInteger)(_requestsCount * kCNMExtraRequestsRatio));
+        if (_retriesCount + _hedgesCount < limit) {
+            
+            *counter += 1;
+            reserved = YES;
+        }
+    });
+    
+    return reserved;
+}
+
+- (NSUInteger)valueOfCounter:(NSUInteger *)counter {
+    
+    __block NSUInteger value = 0;
+    dispatch_sync(self.statisticsAccessQueue, ^{ value = *counter; });
+    
+    return value;
+}
+
+- (void)increaseCounter:(NSUInteger *)counter {
+    
+    dispatch_sync(self.statisticsAccessQueue, ^{ *counter += 1; });
+}
+
+- (BOOL)isTransientError:(NSError *)error {
+    
+    BOOL isTransientError = NO;
+    if ([error.domain isEqualToString:NSURLErrorDomain]) {
+        
+        switch (error.code) {
+            case NSURLErrorTimedOut:
+            case NSURLErrorNetworkConnectionLost:
+            case NSURLErrorCannotConnectToHost:
+            case NSURLErrorCannotFindHost:
+            case NSURLErrorDNSLookupFailed:
+                isTransientError = YES;
+                break;
+            default:
+                break;
+        }
+    }
+    
+    return isTransientError;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,127 @@
+#import <Foundation/Foundation.h>
+#import "CNMBaseRequest.h"
+
+
+#pragma mark Class forward
+
+@class CNMNetworkTask;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Scheduler which decide when shared network tasks can start basing on their priority.
+ @discussion Tasks started from most important to least important and in order in which they has been
+             scheduled if they have same priority. Prefetch and background tasks can't take last free slot, so
+             interactive or visible task can start right away. If there is no free slots, least important task
+             which hasn't started to decode response is preempted and will be started again later.
+             Instance is not thread-safe and should be used from single serial queue (statistics can be read
+             from any queue).
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMRequestScheduler : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores maximum number of tasks which can be started at once.
+ */
+@property (nonatomic, readonly, assign) NSUInteger maximumConcurrentRequests;
+
+/**
+ @brief  Stores reference on block which is called when task can start it's session task.
+ */
+@property (nonatomic, nullable, copy) void(^startHandler)(CNMNetworkTask *task);
+
+/**
+ @brief      Stores reference on block which is called when started task should stop it's session task.
+ @discussion Task will be passed to \c startHandler again as soon as there will be free slot for it.
+ */
+@property (nonatomic, nullable, copy) void(^preemptionHandler)(CNMNetworkTask *task);
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure request scheduler.
+ 
+ @param count Maximum number of tasks which can be started at once.
+ 
+ @return Configured and ready to use scheduler.
+ */
++ (instancetype)schedulerWithMaximumConcurrentRequests:(NSUInteger)count;
+
+/**
+ @brief  Translate request priority to priority which is used by session task.
+ 
+ @param priority Request priority which should be translated.
+ 
+ @return Value which can be used with session task's \c priority property.
+ */
++ (float)sessionTaskPriorityForPriority:(CNMRequestPriority)priority;
+
+
+///------------------------------------------------
+/// @name Scheduling
+///------------------------------------------------
+
+/**
+ @brief  Add task to the scheduler queue and start it if there is free slot.
+ 
+ @param task Reference on shared task which should be started.
+ */
+- (void)scheduleTask:(CNMNetworkTask *)task;
+
+/**
+ @brief  Apply changed task priority (after requests which wait for it or their priorities has been changed).
+ 
+ @param task Reference on shared task which priority has been changed.
+ */
+- (void)updatePriorityOfTask:(CNMNetworkTask *)task;
+
+/**
+ @brief      Remove completed or cancelled task from scheduler and start pending tasks.
+ @discussion Should be called while requests still wait for \c task, so it's statistics will be stored for
+             correct priority.
+ 
+ @param task Reference on shared task which doesn't need slot anymore.
+ */
+- (void)completeTask:(CNMNetworkTask *)task;
+
+
+///------------------------------------------------
+/// @name Statistics
+///------------------------------------------------
+
+/**
+ @brief  Retrieve smoothed time which tasks with specified priority wait before they will be started.
+ 
+ @param priority Priority for which time should be retrieved.
+ 
+ @return Queued time in seconds.
+ */
+- (NSTimeInterval)queuedTimeForPriority:(CNMRequestPriority)priority;
+
+/**
+ @brief  Retrieve smoothed time which tasks with specified priority spend on the wire after start.
+ 
+ @param priority Priority for which time should be retrieved.
+ 
+ @return Transfer time in seconds.
+ */
+- (NSTimeInterval)transferTimeForPriority:(CNMRequestPriority)priority;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,282 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMRequestScheduler.h"
+#import "CNMNetworkTask.h"
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores number of priorities for which statistics is collected.
+ */
+static NSUInteger const kCNMRequestPrioritiesCount = 4;
+
+/**
+ @brief  Stores number of slots which can't be taken by prefetch and background tasks.
+ */
+static NSUInteger const kCNMReservedSlotsCount = 1;
+
+/**
+ @brief  Stores weight of new time measurement in smoothed value.
+ */
+static double const kCNMTimeMeasurementWeight = 0.3f;
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMRequestScheduler () {
+    
+    /**
+     @brief  Stores smoothed time which tasks wait before they will be started (for each priority).
+     */
+    NSTimeInterval _queuedTimes[kCNMRequestPrioritiesCount];
+    
+    /**
+     @brief  Stores smoothed time which tasks spend on the wire after start (for each priority).
+     */
+    NSTimeInterval _transferTimes[kCNMRequestPrioritiesCount];
+}
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger maximumConcurrentRequests;
+
+/**
+ @brief  Stores reference on tasks which wait for free slot (in schedule order).
+ */
+@property (nonatomic) NSMutableArray<CNMNetworkTask *> *pendingTasks;
+
+/**
+ @brief  Stores reference on tasks which has been started.
+ */
+@property (nonatomic) NSMutableArray<CNMNetworkTask *> *runningTasks;
+
+/**
+ @brief  Stores reference on queue which is used to serialize access to statistics.
+ */
+@property (nonatomic) dispatch_queue_t statisticsAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize request scheduler.
+ 
+ @param count Maximum number of tasks which can be started at once.
+ 
+ @return Initialized and ready to use scheduler.
+ */
+- (instancetype)initWithMaximumConcurrentRequests:(NSUInteger)count;
+
+
+#pragma mark - Scheduling
+
+/**
+ @brief  Start most important pending tasks while there is free slots for them.
+ */
+- (void)startPendingTasks;
+
+/**
+ @brief  Find most important pending task.
+ 
+ @return Task which should be started next or \c nil in case if there is no pending tasks.
+ */
+- (nullable CNMNetworkTask *)nextPendingTask;
+
+/**
+ @brief      Stop least important started task to free slot for more important task.
+ @discussion Only prefetch and background tasks can be preempted. Tasks which decode streamed response while it
+             is arriving can't be restarted and never preempted.
+ 
+ @param task Reference on task which require slot.
+ 
+ @return \c YES in case if slot has been freed.
+ */
+- (BOOL)preemptTaskForTask:(CNMNetworkTask *)task;
+
+
+#pragma mark - Statistics
+
+/**
+ @brief  Store measured time in smoothed statistics.
+ 
+ @param time     Measured time in seconds.
+ @param times    Reference on smoothed statistics storage.
+ @param priority Priority of task for which time has been measured.
+ */
+- (void)recordTime:(NSTimeInterval)time inTimes:(NSTimeInterval *)times forPriority:(CNMRequestPriority)priority;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMRequestScheduler
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)schedulerWithMaximumConcurrentRequests:(NSUInteger)count {
+    
+    return [[self alloc] initWithMaximumConcurrentRequests:count];
+}
+
+- (instancetype)initWithMaximumConcurrentRequests:(NSUInteger)count {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        _maximumConcurrentRequests = MAX(count, kCNMReservedSlotsCount + 1);
+        _pendingTasks = [NSMutableArray new];
+        _runningTasks = [NSMutableArray new];
+        _statisticsAccessQueue = dispatch_queue_create("com.continuumluxury.continuum.network.scheduler",
+                                                       DISPATCH_QUEUE_SERIAL);
+    }
+    
+    return self;
+}
+
++ (float)sessionTaskPriorityForPriority:(CNMRequestPriority)priority {
+    
+    float sessionTaskPriority = NSURLSessionTaskPriorityLow;
+    if (priority == CNMRequestInteractivePriority) { sessionTaskPriority = NSURLSessionTaskPriorityHigh; }
+    else if (priority == CNMRequestVisiblePriority) { sessionTaskPriority = NSURLSessionTaskPriorityDefault; }
+    
+    return sessionTaskPriority;
+}
+
+
+#pragma mark - Scheduling
+
+- (void)scheduleTask:(CNMNetworkTask *)task {
+    
+    task.scheduleDate = CFAbsoluteTimeGetCurrent();
+    task.startDate = 0.0f;
+    [self.pendingTasks addObject:task];
+    [self startPendingTasks];
+}
+
+- (void)updatePriorityOfTask:(CNMNetworkTask *)task {
+    
+    if ([self.runningTasks containsObject:task]) {
+        
+        task.dataTask.priority = [CNMRequestScheduler sessionTaskPriorityForPriority:task.priority];
+    }
+    [self startPendingTasks];
+}
+
+- (void)completeTask:(CNMNetworkTask *)task {
+    
+    // Only tasks which received response counted in statistics (not cancelled).
+    if ([self.runningTasks containsObject:task] && task.dataTask.state == NSURLSessionTaskStateCompleted) {
+        
+        NSTimeInterval transferTime = (CFAbsoluteTimeGetCurrent() - task.startDate);
+        [self recordTime:transferTime inTimes:_transferTimes forPriority:task.priority];
+#if DEBUG
+        NSLog(@"<Continuum::Network> Request with priority %lu queued for %.2f ms and transferred in %.2f ms",
+              (unsigned long)task.priority, (task.startDate - task.scheduleDate) * 1000.0f,
+              transferTime * 1000.0f);
+#endif
+    }
+    [self.runningTasks removeObject:task];
+    [self.pendingTasks removeObject:task];
+    [self startPendingTasks];
+}
+
+- (void)startPendingTasks {
+    
+    CNMNetworkTask *task = nil;
+    while ((task = [self nextPendingTask])) {
+        
+        NSUInteger limit = self.maximumConcurrentRequests;
+        if (task.priority > CNMRequestVisiblePriority) { limit -= kCNMReservedSlotsCount; }
+        if (self.runningTasks.count >= limit && ![self preemptTaskForTask:task]) { break; }
+        
+        [self.pendingTasks removeObject:task];
+        [self.runningTasks addObject:task];
+        task.startDate = CFAbsoluteTimeGetCurrent();
+        [self recordTime:(task.startDate - task.scheduleDate) inTimes:_queuedTimes forPriority:task.priority];
+        if (self.startHandler) { self.startHandler(task); }
+    }
+}
+
+- (CNMNetworkTask *)nextPendingTask {
+    
+    CNMNetworkTask *nextTask = nil;
+    for (CNMNetworkTask *task in self.pendingTasks) {
+        
+        if (!nextTask || task.priority < nextTask.priority) { nextTask = task; }
+    }
+    
+    return nextTask;
+}
+
+- (BOOL)preemptTaskForTask:(CNMNetworkTask *)task {
+    
+    if (task.priority > CNMRequestVisiblePriority) { return NO; }
+    
+    CNMNetworkTask *preemptedTask = nil;
+    for (CNMNetworkTask *runningTask in self.runningTasks) {
+        
+        if (runningTask.priority > CNMRequestVisiblePriority && !runningTask.parser &&
+            (!preemptedTask || runningTask.priority > preemptedTask.priority)) {
+            
+            preemptedTask = runningTask;
+        }
+    }
+    
+    if (preemptedTask) {
+        
+        // Preempted task keep it's place in schedule order.
+        [self.runningTasks removeObject:preemptedTask];
+        [self.pendingTasks insertObject:preemptedTask atIndex:0];
+        preemptedTask.startDate = 0.0f;
+        if (self.preemptionHandler) { self.preemptionHandler(preemptedTask); }
+#if DEBUG
+        NSLog(@"<Continuum::Network> Request with priority %lu preempted by request with priority %lu",
+              (unsigned long)preemptedTask.priority, (unsigned long)task.priority);
+#endif
+    }
+    
+    return (preemptedTask != nil);
+}
+
+
+#pragma mark - Statistics
+
+- (NSTimeInterval)queuedTimeForPriority:(CNMRequestPriority)priority {
+    
+    __block NSTimeInterval time = 0.0f;
+    dispatch_sync(self.statisticsAccessQueue, ^{ time = _queuedTimes[priority]; });
+    
+    return time;
+}
+
+- (NSTimeInterval)transferTimeForPriority:(CNMRequestPriority)priority {
+    
+    __block NSTimeInterval time = 0.0f;
+    dispatch_sync(self.statisticsAccessQueue, ^{ time = _transferTimes[priority]; });
+    
+    return time;
+}
+
+- (void)recordTime:(NSTimeInterval)time inTimes:(NSTimeInterval *)times forPriority:(CNMRequestPriority)priority {
+    
+    dispatch_sync(self.statisticsAccessQueue, ^{
+        
+        if (times[priority] <= 0.0f) { times[priority] = time; }
+        else { times[priority] += (time - times[priority]) * kCNMTimeMeasurementWeight; }
+    });
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,131 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ @brief      Persistent cache for remote data provider responses which allow to revalidate them using
+             conditional requests.
+ @discussion Cache store response body along with it's validators (\c ETag and \c Last-Modified) on disk and
+             keep parsed objects in memory, so \c 304 response can be turned into parsed object w/o JSON
+             de-serialization. Instance is thread-safe.
+ 
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+@interface CNMResponseCache : NSObject
+
+
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores how many responses for cacheable requests has been processed.
+ */
+@property (nonatomic, readonly, assign) NSUInteger requestsCount;
+
+/**
+ @brief  Stores how many responses has been served from cache after successful revalidation.
+ */
+@property (nonatomic, readonly, assign) NSUInteger hitsCount;
+
+/**
+ @brief  Stores ratio of responses which has been served from cache to all processed responses.
+ */
+@property (nonatomic, readonly, assign) double hitRate;
+
+/**
+ @brief  Stores how many bytes of response bodies hasn't been downloaded because cached data has been used.
+ */
+@property (nonatomic, readonly, assign) unsigned long long savedBytesCount;
+
+
+///------------------------------------------------
+/// @name Initialization and Configuration
+///------------------------------------------------
+
+/**
+ @brief  Create and configure response cache which will store data in specified directory.
+ 
+ @param name Name of directory inside of application's caches directory.
+ 
+ @return Configured and ready to use response cache.
+ */
++ (instancetype)cacheWithName:(NSString *)name;
+
+
+///------------------------------------------------
+/// @name Validation
+///------------------------------------------------
+
+/**
+ @brief  Retrieve HTTP header fields which should be added to request to revalidate cached response.
+ 
+ @param identifier Canonical remote resource identifier.
+ 
+ @return Dictionary with \c If-None-Match and/or \c If-Modified-Since fields or \c nil in case if there is no
+         cached response for \c identifier.
+ */
+- (nullable NSDictionary<NSString *, NSString *> *)validationHeadersForIdentifier:(NSString *)identifier;
+
+
+///------------------------------------------------
+/// @name Storage
+///------------------------------------------------
+
+/**
+ @brief      Retrieve object which has been stored for revalidated remote resource.
+ @discussion Call should be done in response on \c 304 status code and it will be counted as cache hit.
+ 
+ @param identifier Canonical remote resource identifier.
+ @param parser     Reference on block which is used to process stored response body in case if parsed object
+                   not in memory (evicted or application has been relaunched).
+ 
+ @return Parsed object or \c nil in case if there is no cached response for \c identifier. If stored response
+         body can't be read or processed, validators for \c identifier will be removed, so next request will
+         be sent w/o conditions.
+ */
+- (nullable id)objectForRevalidatedIdentifier:(NSString *)identifier
+                                   withParser:(id _Nullable (^)(NSData *data))parser;
+
+/**
+ @brief      Store response body and it's parsed representation.
+ @discussion Response will be stored only if it has at least one validator. Call will be counted as cache miss.
+ 
+ @param object     Reference on object which has been created from \c data.
+ @param data       Reference on response body.
+ @param response   Reference on HTTP response with validator fields.
+ @param identifier Canonical remote resource identifier.
+ */
+- (void)storeObject:(nullable id)object withData:(nullable NSData *)data forResponse:(NSHTTPURLResponse *)response
+         identifier:(NSString *)identifier;
+
+/**
+ @brief  Check whether parsed object or response body is available for revalidated remote resource.
+ 
+ @param identifier Canonical remote resource identifier.
+ 
+ @return \c YES in case if \c 304 response for \c identifier can be turned into parsed object.
+ */
+- (BOOL)hasResponseForIdentifier:(NSString *)identifier;
+
+/**
+ @brief  Remove stored response and it's validators from memory and disk.
+ 
+ @param identifier Canonical remote resource identifier.
+ */
+- (void)removeResponseForIdentifier:(NSString *)identifier;
+
+/**
+ @brief  Remove all stored responses from memory and disk.
+ */
+- (void)removeAllResponses;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
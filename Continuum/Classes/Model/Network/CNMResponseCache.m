@@ -0,0 +1,346 @@
+/**
+ @author Sergey Mamontov
+ @since 1.1
+ @copyright © 2016 Continuum LLC.
+ */
+#import "CNMResponseCache.h"
+#import <CommonCrypto/CommonDigest.h>
+
+
+#pragma mark Static
+
+/**
+ @brief  Stores reference on key under which stored HTTP header fields which should be used for revalidation.
+ */
+static NSString * const kCNMResponseCacheHeadersKey = @"headers";
+
+/**
+ @brief  Stores reference on key under which stored response body length.
+ */
+static NSString * const kCNMResponseCacheLengthKey = @"length";
+
+
+#pragma mark - Private interface declaration
+
+@interface CNMResponseCache ()
+
+
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger requestsCount;
+@property (nonatomic, assign) NSUInteger hitsCount;
+@property (nonatomic, assign) unsigned long long savedBytesCount;
+
+/**
+ @brief  Stores reference on full path to the directory where responses stored.
+ */
+@property (nonatomic, copy) NSString *directoryPath;
+
+/**
+ @brief  Stores reference on serial queue which is used to access stored data.
+ */
+@property (nonatomic) dispatch_queue_t resourceAccessQueue;
+
+/**
+ @brief  Stores reference on dictionary where each key is remote resource identifier and value is stored
+         response information (validation headers and body length).
+ */
+@property (nonatomic) NSMutableDictionary<NSString *, NSDictionary *> *entries;
+
+/**
+ @brief  Stores reference on in-memory storage for parsed response objects.
+ */
+@property (nonatomic) NSCache *objects;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ @brief  Initialize response cache which will store data in specified directory.
+ 
+ @param name Name of directory inside of application's caches directory.
+ 
+ @return Initialized and ready to use response cache.
+ */
+- (instancetype)initWithName:(NSString *)name;
+
+
+#pragma mark - Misc
+
+/**
+ @brief      Retrieve stored response information.
+ @discussion Information will be loaded from disk if it is not in memory yet. Should be called from
+             \c resourceAccessQueue.
+ 
+ @param identifier Canonical remote resource identifier.
+ 
+ @return Stored response information or \c nil in case if there is no stored response.
+ */
+- (NSDictionary *)entryForIdentifier:(NSString *)identifier;
+
+/**
+ @brief  Compose path to the file which store response data.
+ 
+ @param identifier Canonical remote resource identifier.
+ @param extension  Type of stored data: \c plist for response information and \c json for response body.
+ 
+ @return Full path to the file.
+ */
+- (NSString *)pathForIdentifier:(NSString *)identifier withExtension:(NSString *)extension;
+
+/**
+ @brief      Remove stored response information, body and parsed object.
+ @discussion Should be called from \c resourceAccessQueue.
+ 
+ @param identifier Canonical remote resource identifier.
+ */
+- (void)removeEntryForIdentifier:(NSString *)identifier;
+
+/**
+ @brief  Compose HTTP header fields which allow to revalidate passed response.
+ 
+ @param response Reference on HTTP response from which validators should be taken.
+ 
+ @return Dictionary with \c If-None-Match and/or \c If-Modified-Since fields.
+ */
+- (NSDictionary<NSString *, NSString *> *)validationHeadersFromResponse:(NSHTTPURLResponse *)response;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation CNMResponseCache
+
+
+#pragma mark - Information
+
+- (NSUInteger)requestsCount {
+    
+    __block NSUInteger requestsCount = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{ requestsCount = _requestsCount; });
+    
+    return requestsCount;
+}
+
+- (NSUInteger)hitsCount {
+    
+    __block NSUInteger hitsCount = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{ hitsCount = _hitsCount; });
+    
+    return hitsCount;
+}
+
+- (unsigned long long)savedBytesCount {
+    
+    __block unsigned long long savedBytesCount = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{ savedBytesCount = _savedBytesCount; });
+    
+    return savedBytesCount;
+}
+
+- (double)hitRate {
+    
+    __block double hitRate = 0.0f;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        hitRate = (_requestsCount > 0 ? (double)_hitsCount / (double)_requestsCount : 0.0f);
+    });
+    
+    return hitRate;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)cacheWithName:(NSString *)name {
+    
+    return [[self alloc] initWithName:name];
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES)[0];
+        _directoryPath = [cachesPath stringByAppendingPathComponent:name];
+        _resourceAccessQueue = dispatch_queue_create("com.continuumluxury.continuum.network.cache",
+                                                     DISPATCH_QUEUE_SERIAL);
+        _entries = [NSMutableDictionary new];
+        _objects = [NSCache new];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_directoryPath withIntermediateDirectories:YES
+                                                   attributes:nil error:nil];
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Validation
+
+- (NSDictionary<NSString *, NSString *> *)validationHeadersForIdentifier:(NSString *)identifier {
+    
+    __block NSDictionary *headers = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        headers = [self entryForIdentifier:identifier][kCNMResponseCacheHeadersKey];
+    });
+    
+    return headers;
+}
+
+
+#pragma mark - Storage
+
+- (id)objectForRevalidatedIdentifier:(NSString *)identifier withParser:(id(^)(NSData *data))parser {
+    
+    __block id object = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        NSDictionary *entry = [self entryForIdentifier:identifier];
+        object = [self.objects objectForKey:identifier];
+        if (!object && entry) {
+            
+            // Parsed object has been evicted from memory or not loaded yet since application launch.
+            NSData *data = [NSData dataWithContentsOfFile:[self pathForIdentifier:identifier withExtension:@"json"]
+                                                  options:NSDataReadingMappedIfSafe error:nil];
+            object = (data.length ? parser(data) : nil);
+            if (object) { [self.objects setObject:object forKey:identifier cost:data.length]; }
+            else {
+                
+                // Validators useless w/o response body, so next request should download it again.
+                [self removeEntryForIdentifier:identifier];
+            }
+        }
+        
+        _requestsCount++;
+        if (object) {
+            
+            _hitsCount++;
+            _savedBytesCount += ((NSNumber *)entry[kCNMResponseCacheLengthKey]).unsignedLongLongValue;
+        }
+    });
+    
+    return object;
+}
+
+- (void)storeObject:(id)object withData:(NSData *)data forResponse:(NSHTTPURLResponse *)response
+         identifier:(NSString *)identifier {
+    
+    NSDictionary *headers = [self validationHeadersFromResponse:response];
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        _requestsCount++;
+        NSString *entryPath = [self pathForIdentifier:identifier withExtension:@"plist"];
+        NSString *bodyPath = [self pathForIdentifier:identifier withExtension:@"json"];
+        if (headers.count && data.length && object) {
+            
+            NSDictionary *entry = @{kCNMResponseCacheHeadersKey: headers,
+                                    kCNMResponseCacheLengthKey: @(data.length)};
+            self.entries[identifier] = entry;
+            [self.objects setObject:object forKey:identifier cost:data.length];
+            [data writeToFile:bodyPath atomically:YES];
+            [entry writeToFile:entryPath atomically:YES];
+        }
+        else if (self.entries[identifier] || [[NSFileManager defaultManager] fileExistsAtPath:entryPath]) {
+            
+            // Remote data provider stopped to send validators for this resource.
+            [self removeEntryForIdentifier:identifier];
+        }
+    });
+}
+
+- (BOOL)hasResponseForIdentifier:(NSString *)identifier {
+    
+    __block BOOL hasResponse = NO;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        
+        NSString *bodyPath = [self pathForIdentifier:identifier withExtension:@"json"];
+        hasResponse = ([self.objects objectForKey:identifier] != nil ||
+                       [[NSFileManager defaultManager] isReadableFileAtPath:bodyPath]);
+    });
+    
+    return hasResponse;
+}
+
+- (void)removeResponseForIdentifier:(NSString *)identifier {
+    
+    dispatch_sync(self.resourceAccessQueue, ^{ [self removeEntryForIdentifier:identifier]; });
+}
+
+- (void)removeAllResponses {
+    
+    dispatch_async(self.resourceAccessQueue, ^{
+        
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        [self.entries removeAllObjects];
+        [self.objects removeAllObjects];
+        [fileManager removeItemAtPath:self.directoryPath error:nil];
+        [fileManager createDirectoryAtPath:self.directoryPath withIntermediateDirectories:YES attributes:nil
+                                     error:nil];
+    });
+}
+
+
+#pragma mark - Misc
+
+- (NSDictionary *)entryForIdentifier:(NSString *)identifier {
+    
+    NSDictionary *entry = self.entries[identifier];
+    if (!entry) {
+        
+        NSString *entryPath = [self pathForIdentifier:identifier withExtension:@"plist"];
+        entry = [NSDictionary dictionaryWithContentsOfFile:entryPath];
+        if (entry) { self.entries[identifier] = entry; }
+    }
+    
+    return entry;
+}
+
+- (void)removeEntryForIdentifier:(NSString *)identifier {
+    
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [self.entries removeObjectForKey:identifier];
+    [self.objects removeObjectForKey:identifier];
+    [fileManager removeItemAtPath:[self pathForIdentifier:identifier withExtension:@"plist"] error:nil];
+    [fileManager removeItemAtPath:[self pathForIdentifier:identifier withExtension:@"json"] error:nil];
+}
+
+- (NSString *)pathForIdentifier:(NSString *)identifier withExtension:(NSString *)extension {
+    
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    NSData *identifierData = [identifier dataUsingEncoding:NSUTF8StringEncoding];
+    CC_SHA1(identifierData.bytes, (CC_LONG)identifierData.length, digest);
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:(CC_SHA1_DIGEST_LENGTH * 2)];
+    for (NSUInteger byteIdx = 0; byteIdx < CC_SHA1_DIGEST_LENGTH; byteIdx++) {
+        
+        [fileName appendFormat:@"%02x", digest[byteIdx]];
+    }
+    
+    return [self.directoryPath stringByAppendingPathComponent:[fileName stringByAppendingPathExtension:extension]];
+}
+
+- (NSDictionary<NSString *, NSString *> *)validationHeadersFromResponse:(NSHTTPURLResponse *)response {
+    
+    NSMutableDictionary *headers = [NSMutableDictionary new];
+    [response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(NSString *field, NSString *value,
+                                                                  BOOL *fieldsEnumeratorStop) {
+        
+        if ([field caseInsensitiveCompare:@"ETag"] == NSOrderedSame) { headers[@"If-None-Match"] = value; }
+        else if ([field caseInsensitiveCompare:@"Last-Modified"] == NSOrderedSame) {
+            
+            headers[@"If-Modified-Since"] = value;
+        }
+    }];
+    
+    return headers;
+}
+
+#pragma mark -
+
+
+@end
@@ -34,9 +34,33 @@
 @property (nonatomic, copy) NSDictionary *HTTPHeaders;
 
 /**
- @brief  Stores reference on started task instance.
+ @brief  Stores reference on name of response root object member which store collection which can be decoded
+         while response is still arriving.
  */
-@property (nonatomic) NSURLSessionDataTask *activeTask;
+@property (nonatomic, copy) NSString *streamedCollectionKey;
+
+/**
+ @brief  Stores whether responses for this request should be stored and revalidated with conditional requests.
+ */
+@property (nonatomic, assign, getter = shouldUseResponseCache) BOOL useResponseCache;
+
+/**
+ @brief  Stores how many times request can be repeated after timeout, lost connection or server error (\c 1 by
+         default).
+ */
+@property (nonatomic, assign) NSUInteger maximumRetriesCount;
+
+/**
+ @brief  Stores whether duplicate request can be sent when response doesn't arrive in usual for this request
+         class time.
+ */
+@property (nonatomic, assign, getter = isHedgeable) BOOL hedgeable;
+
+/**
+ @brief      Stores reference on identifier of transport task which pull out data for request.
+ @discussion Identifier include client's authorization scope, so it can't be composed from request model alone.
+ */
+@property (nonatomic, copy) NSString *taskIdentifier;
 
 
 #pragma mark - Initialization and Configuration
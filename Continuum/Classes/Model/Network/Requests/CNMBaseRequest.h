@@ -1,6 +1,53 @@
 #import <Foundation/Foundation.h>
 
 
+#pragma mark Types and Structures
+
+/**
+ @brief  Represent enumerator with possible request priorities (from most to least important).
+ */
+typedef NS_ENUM(NSUInteger, CNMRequestPriority) {
+    
+    /**
+     @brief  User is waiting for response right now (for example to start video playback).
+     */
+    CNMRequestInteractivePriority,
+    
+    /**
+     @brief  Response provide data which should be shown on screen (feed pages).
+     */
+    CNMRequestVisiblePriority,
+    
+    /**
+     @brief  Response provide data which will be shown soon (next feed pages).
+     */
+    CNMRequestPrefetchPriority,
+    
+    /**
+     @brief  Response complete data which already has been shown (credits).
+     */
+    CNMRequestBackgroundPriority
+};
+
+/**
+ @brief  Represent enumerator with possible lanes in which response processing can be scheduled.
+ */
+typedef NS_ENUM(NSUInteger, CNMRequestLane) {
+    
+    /**
+     @brief  Response is waited by the user (feed pages and video information) and processed before responses
+             from other lanes.
+     */
+    CNMRequestUserInitiatedLane,
+    
+    /**
+     @brief  Response is requested ahead of time (prefetched pages and credits) and processed only when there is
+             free workers.
+     */
+    CNMRequestBackgroundLane
+};
+
+
 /**
  @brief  Basic remote resource description used by network manager.
  
@@ -11,6 +58,23 @@
 @interface CNMBaseRequest : NSObject
 
 
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief      Stores how important request is (\c CNMRequestVisiblePriority by default).
+ @discussion Priority of request which already has been passed to network manager should be changed with
+             \c -updatePriority:forRequest:.
+ */
+@property (nonatomic, assign) CNMRequestPriority priority;
+
+/**
+ @brief  Stores in which lane response for this request should be processed (depends on \c priority).
+ */
+@property (nonatomic, readonly, assign) CNMRequestLane lane;
+
+
 ///------------------------------------------------
 /// @name Initialization and Configuration
 ///------------------------------------------------
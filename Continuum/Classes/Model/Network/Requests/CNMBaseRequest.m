@@ -31,6 +31,14 @@
 @implementation CNMBaseRequest
 
 
+#pragma mark - Information
+
+- (CNMRequestLane)lane {
+    
+    return (self.priority <= CNMRequestVisiblePriority ? CNMRequestUserInitiatedLane : CNMRequestBackgroundLane);
+}
+
+
 #pragma mark - Initialization and Configuration
 
 + (instancetype)requestWithBaseURL:(NSURL *)url {
@@ -44,6 +52,8 @@
     if ((self = [super init])) {
         
         _baseURL = url;
+        _priority = CNMRequestVisiblePriority;
+        _maximumRetriesCount = 1;
     }
     
     return self;
@@ -69,10 +79,12 @@
     
     NSMutableString *urlString = [NSMutableString stringWithString:self.path];
     NSMutableArray *queryPairs = [NSMutableArray new];
-    [self.query enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *queryFieldsEnumeratorStop) {
+    // Keys sorted to make sure what same query will produce same URL (used to identify in-flight requests).
+    NSArray *keys = [self.query.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    for (NSString *key in keys) {
         
-        [queryPairs addObject:[NSString stringWithFormat:@"%@=%@", key, value]];
-    }];
+        [queryPairs addObject:[NSString stringWithFormat:@"%@=%@", key, self.query[key]]];
+    }
     if (queryPairs.count) { [urlString appendFormat:@"?%@", [queryPairs componentsJoinedByString:@"&"]]; }
     
     return [NSURL URLWithString:urlString relativeToURL:self.baseURL];
@@ -13,6 +13,16 @@ NS_ASSUME_NONNULL_BEGIN
 @interface CNMVimeoChannelVideosRequest : CNMVimeoRequest
 
 
+///------------------------------------------------
+/// @name Information
+///------------------------------------------------
+
+/**
+ @brief  Stores maximum number of entries which is requested with page.
+ */
+@property (nonatomic, readonly, assign) NSUInteger numberOfEntries;
+
+
 ///------------------------------------------------
 /// @name Initialization and Configuration
 ///------------------------------------------------
@@ -31,6 +41,18 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)requestForChannel:(NSString *)identifier toFetch:(NSUInteger)numberOfEntries 
                    withPageOffset:(NSUInteger)page;
 
+/**
+ @brief      Construct and configure request which will allow to retrieve page of entries which is referenced by
+             remote data provider pagination cursor.
+ @discussion Page index and page size used exactly as they has been provided with cursor.
+ 
+ @param cursor Reference on next page URI which has been provided by remote data provider along with previous
+               page (\c paging.next).
+ 
+ @return Configured and ready to use request model instance.
+ */
++ (instancetype)requestWithCursor:(NSString *)cursor;
+
 #pragma mark -
 
 
@@ -7,11 +7,33 @@
 #import "CNMBaseRequest+Private.h"
 
 
-#pragma mark Private interface declaration
+#pragma mark Static
+
+/**
+ @brief  Stores number of entries which remote data provider return with page if cursor doesn't specify it.
+ */
+static NSUInteger const kCNMDefaultEntriesPerPage = 25;
+
+/**
+ @brief      Stores reference on list of fields which is required to show entries in feed.
+ @discussion Video file presets requested only for entries which can be played soon with
+             \c CNMVimeoVideoRequest. Duration requested along with them, because it is stored in presets
+             and shown only by player. Fields filter can't pick single element of \c pictures.sizes list, so
+             only height and link of each size requested and size which fit screen picked on device.
+ */
+static NSString * const kCNMFeedEntryFields = @"link,name,created_time,pictures.sizes.height,pictures.sizes.link";
+
+
+#pragma mark - Private interface declaration
 
 @interface CNMVimeoChannelVideosRequest ()
 
 
+#pragma mark - Properties
+
+@property (nonatomic, assign) NSUInteger numberOfEntries;
+
+
 #pragma mark - Initialization and Configuration
 
 /**
@@ -27,6 +49,16 @@
 - (instancetype)initWithChannel:(NSString *)identifier toFetch:(NSUInteger)numberOfEntries
                  withPageOffset:(NSUInteger)page;
 
+/**
+ @brief  Initialize request which will allow to retrieve page of entries which is referenced by remote data
+         provider pagination cursor.
+ 
+ @param cursor Reference on next page URI which has been provided by remote data provider.
+ 
+ @return Initialized and ready to use request model instance.
+ */
+- (instancetype)initWithCursor:(NSString *)cursor;
+
 
 #pragma mark - Misc
 
@@ -68,6 +100,11 @@
     return [[self alloc] initWithChannel:identifier toFetch:numberOfEntries withPageOffset:page];
 }
 
++ (instancetype)requestWithCursor:(NSString *)cursor {
+    
+    return [[self alloc] initWithCursor:cursor];
+}
+
 - (instancetype)initWithChannel:(NSString *)identifier toFetch:(NSUInteger)numberOfEntries 
                  withPageOffset:(NSUInteger)page {
     
@@ -76,6 +113,41 @@
         
         self.path = [self pathForChannel:identifier];
         self.query = [self queryForEntriesAtPage:page count:numberOfEntries];
+        self.numberOfEntries = numberOfEntries;
+        self.streamedCollectionKey = @"data";
+        self.maximumRetriesCount = 2;
+        self.hedgeable = YES;
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithCursor:(NSString *)cursor {
+    
+    // Check whether initialization was successful or not.
+    if ((self = [super init])) {
+        
+        NSURLComponents *components = [NSURLComponents componentsWithString:cursor];
+        NSMutableDictionary *cursorQuery = [NSMutableDictionary new];
+        for (NSURLQueryItem *item in components.queryItems) {
+            
+            if (item.value) { cursorQuery[item.name] = item.value; }
+        }
+        
+        // Pages addressed with integer values which has been provided by remote data provider. Cursor parameters
+        // override defaults, so page is requested exactly as it has been referenced.
+        NSUInteger page = MAX((NSUInteger)[cursorQuery[@"page"] integerValue], 1);
+        NSUInteger count = (NSUInteger)[cursorQuery[@"per_page"] integerValue];
+        if (count == 0) { count = kCNMDefaultEntriesPerPage; }
+        NSMutableDictionary *query = [[self queryForEntriesAtPage:page count:count] mutableCopy];
+        [cursorQuery removeObjectsForKeys:@[@"page", @"per_page"]];
+        [query addEntriesFromDictionary:cursorQuery];
+        self.path = components.path;
+        self.query = query;
+        self.numberOfEntries = count;
+        self.streamedCollectionKey = @"data";
+        self.maximumRetriesCount = 2;
+        self.hedgeable = YES;
     }
     
     return self;
@@ -92,8 +164,7 @@
 - (NSDictionary *)queryForEntriesAtPage:(NSUInteger)page count:(NSUInteger)count {
     
     return @{@"direction": @"desc", @"page": @(page), @"per_page": @(count), @"sort": @"added",
-             @"fields": @"link,name,created_time,description,duration,pictures.sizes,files.quality,"
-                         "files.width,files.height,files.link_secure,files.quality.size"};
+             @"fields": kCNMFeedEntryFields};
 }
 
 #pragma mark -
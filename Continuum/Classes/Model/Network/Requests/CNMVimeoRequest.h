@@ -24,6 +24,22 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)setAccessToken:(NSString *)token;
 
+/**
+ @brief      Configure base URL against which requests to remote data provider should be done.
+ @discussion Allow to send requests to stand-in which replay recorded responses. Should be configured before
+             any request will be created.
+ 
+ @param url Reference on remote data provider base URL (\c nil to use Vimeo API).
+ */
++ (void)setBaseURL:(nullable NSURL *)url;
+
+/**
+ @brief  Retrieve base URL against which requests to remote data provider is done.
+ 
+ @return Configured or Vimeo API base URL.
+ */
++ (NSURL *)baseURL;
+
 #pragma mark -
 
 
@@ -19,6 +19,11 @@ static NSString * const kCNMRemoteDataProvierBaseURL = @"https://api.vimeo.com";
  */
 static NSString *CNMAccessToken;
 
+/**
+ @brief  Stores user-provided base URL which should be used instead of \c kCNMRemoteDataProvierBaseURL.
+ */
+static NSURL *CNMBaseURL;
+
 
 #pragma mark - Private interface declaration
 
@@ -51,12 +56,23 @@ static NSString *CNMAccessToken;
     CNMAccessToken = token;
 }
 
++ (void)setBaseURL:(NSURL *)url {
+    
+    CNMBaseURL = url;
+}
+
++ (NSURL *)baseURL {
+    
+    return (CNMBaseURL ?: [NSURL URLWithString:kCNMRemoteDataProvierBaseURL]);
+}
+
 - (instancetype)init {
     
     // Check whether initialization was successful or not.
-    if ((self = [super initWithBaseURL:[NSURL URLWithString:kCNMRemoteDataProvierBaseURL]])) {
+    if ((self = [super initWithBaseURL:[CNMVimeoRequest baseURL]])) {
         
         self.HTTPHeaders = [self requestHeaders];
+        self.useResponseCache = YES;
     }
     
     return self;
@@ -71,6 +71,9 @@
     if ((self = [super init])) {
         
         self.path = [self pathForVideoCredits:video];
+        
+        // Credits only complete entries which already shown to the user.
+        self.priority = CNMRequestBackgroundPriority;
     }
     
     return self;
@@ -9,8 +9,10 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- @brief  Request model which describe way to retrieve single video entry information from remote data 
-         provider.
+ @brief      Request model which describe way to retrieve single video entry information from remote data
+             provider.
+ @discussion Only information which is required for playback (video file presets) is requested, because
+             information which is shown in feed arrive with channel pages.
  
  @author Sergey Mamontov
  @since 1.0
@@ -8,7 +8,16 @@
 #import "CNMVideo.h"
 
 
-#pragma mark Private interface declaration
+#pragma mark Static
+
+/**
+ @brief  Stores reference on list of fields which is required to start video playback.
+ */
+static NSString * const kCNMVideoPlaybackFields = @"link,duration,files.quality,files.width,files.height,"
+                                                   "files.size,files.link_secure";
+
+
+#pragma mark - Private interface declaration
 
 @interface CNMVimeoVideoRequest ()
 
@@ -61,6 +70,9 @@
     if ((self = [super init])) {
         
         self.path = [self pathForVideo:video];
+        self.query = @{@"fields": kCNMVideoPlaybackFields};
+        self.maximumRetriesCount = 2;
+        self.hedgeable = YES;
     }
     
     return self;
@@ -30,6 +30,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)upateForVideo:(CNMVideo *)video;
 
+/**
+ @brief      Refresh title and author information if passed video is presented at this moment.
+ @discussion Used to show information which arrived (or has been restored from stub) after video entry has
+             been presented.
+ 
+ @param video Reference on instance which has been updated.
+ */
+- (void)updateForChangedVideo:(CNMVideo *)video;
+
 #pragma mark - 
 
 
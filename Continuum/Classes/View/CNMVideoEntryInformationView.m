@@ -25,6 +25,11 @@
  */
 @property (nonatomic, weak) IBOutlet CNMLabel *authorLabel;
 
+/**
+ @brief  Stores reference on identifier of video which is presented at this moment.
+ */
+@property (nonatomic, copy) NSString *videoIdentifier;
+
 #pragma mark -
 
 
@@ -40,10 +45,20 @@
 
 - (void)upateForVideo:(CNMVideo *)video {
     
+    self.videoIdentifier = video.identifier;
     self.titleLabel.text = video.name;
     self.authorLabel.text = video.author;
 }
 
+- (void)updateForChangedVideo:(CNMVideo *)video {
+    
+    if ([video.identifier isEqualToString:self.videoIdentifier]) {
+        
+        self.titleLabel.text = video.name;
+        self.authorLabel.text = video.author;
+    }
+}
+
 #pragma mark -
 
 